@@ -0,0 +1,410 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_APPROXIMATETIMESYNCHRONIZER_H_
+#define RTIDDSSMARTSOFT_APPROXIMATETIMESYNCHRONIZER_H_
+
+#include "RTI-DDS-SmartSoft/Task.h"
+#include "RTI-DDS-SmartSoft/PushClientPattern.h"
+
+#include <array>
+#include <tuple>
+#include <limits>
+#include <cstdlib>
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#include <chrono>
+#include <utility>
+#include <functional>
+#include <condition_variable>
+
+namespace SmartDDS {
+
+/** Joins the updates of several PushClientPatterns by their source timestamps.
+ *
+ *  Each attached stream buffers its latest updates in a pre-allocated ring buffer
+ *  (the updates are shared with the PushClientPattern, i.e. they are not copied).
+ *  A single dispatch thread matches the buffered updates and calls the callback with
+ *  one update per stream, whose timestamps differ by at most the configured slop
+ *  (i.e. the newest and the oldest update of a matched set are at most slop apart).
+ *  The matching is pivoted on the stream whose oldest buffered update is the newest one:
+ *  older updates of the other streams outside of the slop can never be matched anymore and
+ *  are discarded (counted as unmatched). Among the time windows of size slop that contain the
+ *  pivot and one update of each stream, the updates closest to the pivot are selected.
+ *  Updates overwritten in a full ring buffer before they could be matched are counted as dropped.
+ *
+ *  \code
+ *  SmartDDS::ApproximateTimeSynchronizer<CommImage, CommDepthImage, CommBasePose> synchronizer(
+ *  	component,
+ *  	[](const std::chrono::system_clock::time_point &time, const CommImage &image, const CommDepthImage &depth, const CommBasePose &pose) {
+ *  		// process the matched set
+ *  	},
+ *  	std::chrono::milliseconds(10), 16,
+ *  	imageClient, depthClient, poseClient);
+ *  \endcode
+ */
+template <class... DataTypes>
+class ApproximateTimeSynchronizer
+:	public SmartDDS::Task
+{
+public:
+	static constexpr size_t NUMBER_OF_STREAMS = sizeof...(DataTypes);
+
+	using TimePoint = std::chrono::system_clock::time_point;
+	using Callback = std::function<void(const TimePoint &time, const DataTypes&... values)>;
+
+	struct Statistics {
+		// the number of matched sets passed to the callback
+		uint64_t matched_sets = 0;
+		// per stream, the updates overwritten in the full ring buffer before they could be matched
+		std::array<uint64_t, NUMBER_OF_STREAMS> dropped_updates;
+		// per stream, the updates discarded because no matching updates of the other streams exist
+		std::array<uint64_t, NUMBER_OF_STREAMS> unmatched_updates;
+
+		Statistics() {
+			dropped_updates.fill(0);
+			unmatched_updates.fill(0);
+		}
+	};
+
+private:
+	template <size_t StreamIndex, class DataType>
+	class Stream : public PushUpdateObserver<DataType> {
+	public:
+		static constexpr size_t stream_index = StreamIndex;
+
+		using ValuePtr = std::shared_ptr<const DataType>;
+		struct Entry {
+			int64_t timestamp;
+			ValuePtr value;
+		};
+
+		ApproximateTimeSynchronizer *synchronizer;
+		PushClientPattern<DataType> *client;
+
+		// the ring buffer is allocated once (and is only accessed while holding the synchronizer's mutex)
+		std::vector<Entry> entries;
+		size_t head;
+		size_t count;
+
+		Stream(ApproximateTimeSynchronizer *synchronizer, const size_t &capacity, PushClientPattern<DataType> *client)
+		:	synchronizer(synchronizer)
+		,	client(client)
+		,	entries(capacity > 0 ? capacity : 1)
+		,	head(0)
+		,	count(0)
+		{  }
+
+		const Entry& at(const size_t &offset) const {
+			return entries[(head + offset) % entries.size()];
+		}
+		// returns false if the oldest entry had to be overwritten
+		bool push_back(const int64_t &timestamp, const ValuePtr &value) {
+			bool overwritten = false;
+			if(count == entries.size()) {
+				pop_front();
+				overwritten = true;
+			}
+			auto &entry = entries[(head + count) % entries.size()];
+			entry.timestamp = timestamp;
+			entry.value = value;
+			++count;
+			return !overwritten;
+		}
+		void pop_front() {
+			entries[head].value.reset();
+			head = (head + 1) % entries.size();
+			--count;
+		}
+		void clear() {
+			while(count > 0) {
+				pop_front();
+			}
+		}
+
+		virtual void on_push_update(const ValuePtr &data, const TimePoint &timestamp) override {
+			synchronizer->on_stream_update(*this, data, timestamp);
+		}
+	};
+
+	// the streams are numbered, as the same data type might be synchronized several times
+	template <class Sequence>
+	struct StreamTuple;
+	template <size_t... Indices>
+	struct StreamTuple<std::index_sequence<Indices...>> {
+		using type = std::tuple<Stream<Indices, DataTypes>...>;
+	};
+	using Streams = typename StreamTuple<std::index_sequence_for<DataTypes...>>::type;
+
+	Streams streams;
+
+	Callback callback;
+	const int64_t slop;
+
+	std::mutex synchronizer_mutex;
+	std::condition_variable update_condition;
+	bool pending_updates;
+	bool stopping;
+	Statistics statistics;
+
+	static int64_t to_nanoseconds(const TimePoint &time) {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+	}
+
+	template <class Function, size_t... Indices>
+	void for_each_stream(Function &&function, std::index_sequence<Indices...>) {
+		int expand[] = {0, (function(std::get<Indices>(streams)), 0)...};
+		(void)expand;
+	}
+	template <class Function>
+	void for_each_stream(Function &&function) {
+		for_each_stream(std::forward<Function>(function), std::index_sequence_for<DataTypes...>());
+	}
+
+	// the offset of the update within [window_begin, window_begin + slop] closest to the pivot (or count if there is none)
+	template <class StreamType>
+	size_t select_update(const StreamType &stream, const int64_t &window_begin, const int64_t &pivot) const
+	{
+		size_t selected = stream.count;
+		for(size_t offset=0; offset<stream.count; ++offset) {
+			auto timestamp = stream.at(offset).timestamp;
+			if(timestamp < window_begin || timestamp > window_begin + slop)
+				continue;
+			if(selected == stream.count || std::abs(timestamp - pivot) < std::abs(stream.at(selected).timestamp - pivot)) {
+				selected = offset;
+			}
+		}
+		return selected;
+	}
+
+	template <class StreamType, class DataType>
+	void on_stream_update(StreamType &stream, const std::shared_ptr<const DataType> &data, const TimePoint &timestamp)
+	{
+		std::unique_lock<std::mutex> synchronizer_lock(synchronizer_mutex);
+		if(!stream.push_back(to_nanoseconds(timestamp), data)) {
+			statistics.dropped_updates[stream.stream_index]++;
+		}
+		pending_updates = true;
+		update_condition.notify_one();
+	}
+
+	/** looks for the next matching set (the caller holds the synchronizer's mutex)
+	 *
+	 * @return true if a set has been found (and removed from the ring buffers)
+	 */
+	bool find_matching_set(std::tuple<std::shared_ptr<const DataTypes>...> &matched_set, int64_t &pivot)
+	{
+		while(true) {
+			bool complete = true;
+			for_each_stream([&](const auto &stream) {
+				complete = complete && stream.count > 0;
+			});
+			if(!complete)
+				return false;
+
+			// the pivot is the newest of the oldest buffered updates
+			pivot = std::numeric_limits<int64_t>::min();
+			for_each_stream([&](const auto &stream) {
+				pivot = std::max(pivot, stream.at(0).timestamp);
+			});
+
+			// older updates can not be matched anymore (neither with the pivot nor with any later update)
+			for_each_stream([&](auto &stream) {
+				while(stream.count > 0 && stream.at(0).timestamp < pivot - slop) {
+					stream.pop_front();
+					statistics.unmatched_updates[stream.stream_index]++;
+				}
+				complete = complete && stream.count > 0;
+			});
+			if(!complete)
+				return false;
+
+			// all updates of a set must lie within one window [window_begin, window_begin + slop] that contains the pivot,
+			// the window starts at one of the buffered timestamps (the oldest updates always form a valid set, as
+			// they lie within [pivot - slop, pivot]); the window with the updates closest to the pivot is used
+			int64_t best_window_begin = pivot - slop;
+			int64_t best_distance = std::numeric_limits<int64_t>::max();
+			for_each_stream([&](const auto &candidate_stream) {
+				for(size_t candidate=0; candidate<candidate_stream.count; ++candidate) {
+					auto window_begin = candidate_stream.at(candidate).timestamp;
+					if(window_begin < pivot - slop || window_begin > pivot)
+						continue;
+					bool found = true;
+					int64_t distance = 0;
+					for_each_stream([&](const auto &stream) {
+						auto selected = select_update(stream, window_begin, pivot);
+						if(selected == stream.count) {
+							found = false;
+						} else {
+							distance += std::abs(stream.at(selected).timestamp - pivot);
+						}
+					});
+					if(found && distance < best_distance) {
+						best_distance = distance;
+						best_window_begin = window_begin;
+					}
+				}
+			});
+
+			// select the updates of the best window and discard the older ones
+			for_each_stream([&](auto &stream) {
+				size_t selected = select_update(stream, best_window_begin, pivot);
+				for(size_t offset=0; offset<selected; ++offset) {
+					stream.pop_front();
+					statistics.unmatched_updates[stream.stream_index]++;
+				}
+				std::get<std::decay_t<decltype(stream)>::stream_index>(matched_set) = stream.at(0).value;
+				stream.pop_front();
+			});
+			statistics.matched_sets++;
+			return true;
+		}
+	}
+
+	template <size_t... Indices>
+	void dispatch(const int64_t &pivot, const std::tuple<std::shared_ptr<const DataTypes>...> &matched_set, std::index_sequence<Indices...>)
+	{
+		auto time = TimePoint(std::chrono::duration_cast<TimePoint::duration>(std::chrono::nanoseconds(pivot)));
+		callback(time, *std::get<Indices>(matched_set)...);
+	}
+
+	virtual int task_execution() override
+	{
+		std::unique_lock<std::mutex> synchronizer_lock(synchronizer_mutex);
+		while(!stopping && !this->test_canceled()) {
+			update_condition.wait(synchronizer_lock, [this]() { return pending_updates || stopping; });
+			pending_updates = false;
+
+			std::tuple<std::shared_ptr<const DataTypes>...> matched_set;
+			int64_t pivot = 0;
+			while(!stopping && find_matching_set(matched_set, pivot)) {
+				// the callback is called without holding the mutex, so new updates are buffered meanwhile
+				synchronizer_lock.unlock();
+				if(callback) {
+					dispatch(pivot, matched_set, std::index_sequence_for<DataTypes...>());
+				}
+				matched_set = std::tuple<std::shared_ptr<const DataTypes>...>();
+				synchronizer_lock.lock();
+			}
+		}
+		return 0;
+	}
+
+public:
+	/** Creates the synchronizer, attaches it to the given clients and starts the dispatch thread.
+	 *
+	 *  @param component    the pointer to the surrounding component
+	 *  @param callback     is called (from within the dispatch thread) with the pivot time and one update per stream
+	 *  @param slop         the maximal time difference between the updates of a matched set
+	 *  @param buffer_size  the number of buffered updates per stream
+	 *  @param clients      the (connected or not yet connected) push clients, one per data type
+	 */
+	ApproximateTimeSynchronizer(Smart::IComponent *component, const Callback &callback,
+			const Smart::Duration &slop, const size_t &buffer_size,
+			PushClientPattern<DataTypes>&... clients)
+	:	SmartDDS::Task(component)
+	,	streams(create_streams(buffer_size, std::index_sequence_for<DataTypes...>(), clients...))
+	,	callback(callback)
+	,	slop(std::chrono::duration_cast<std::chrono::nanoseconds>(slop).count())
+	,	pending_updates(false)
+	,	stopping(false)
+	{
+		for_each_stream([](auto &stream) {
+			stream.client->attachUpdateObserver(&stream);
+		});
+		this->start();
+	}
+
+	virtual ~ApproximateTimeSynchronizer()
+	{
+		for_each_stream([](auto &stream) {
+			stream.client->detachUpdateObserver(&stream);
+		});
+		this->stop();
+	}
+
+	// restarts the dispatch thread after stop()
+	virtual int start() override {
+		{
+			std::unique_lock<std::mutex> synchronizer_lock(synchronizer_mutex);
+			stopping = false;
+		}
+		return SmartDDS::Task::start();
+	}
+
+	virtual int stop(const bool wait_till_stopped=true) override
+	{
+		{
+			std::unique_lock<std::mutex> synchronizer_lock(synchronizer_mutex);
+			stopping = true;
+			update_condition.notify_one();
+		}
+		return SmartDDS::Task::stop(wait_till_stopped);
+	}
+
+	/** discards all buffered (not yet matched) updates */
+	void reset()
+	{
+		std::unique_lock<std::mutex> synchronizer_lock(synchronizer_mutex);
+		for_each_stream([](auto &stream) {
+			stream.clear();
+		});
+	}
+
+	Statistics getStatistics()
+	{
+		std::unique_lock<std::mutex> synchronizer_lock(synchronizer_mutex);
+		return statistics;
+	}
+
+private:
+	template <size_t... Indices>
+	Streams create_streams(const size_t &buffer_size, std::index_sequence<Indices...>, PushClientPattern<DataTypes>&... clients)
+	{
+		return Streams(Stream<Indices, DataTypes>(this, buffer_size, &clients)...);
+	}
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_APPROXIMATETIMESYNCHRONIZER_H_ */
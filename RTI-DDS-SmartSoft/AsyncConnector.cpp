@@ -0,0 +1,92 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#include "RTI-DDS-SmartSoft/AsyncConnector.h"
+
+namespace SmartDDS {
+
+AsyncConnector::~AsyncConnector()
+{
+	wait();
+}
+
+std::future<Smart::StatusCode> AsyncConnector::start(const std::function<Smart::StatusCode()> &connect)
+{
+	auto connect_promise = std::make_shared<std::promise<Smart::StatusCode>>();
+	auto connect_future = connect_promise->get_future();
+
+	std::unique_lock<std::mutex> connector_lock(connector_mutex);
+	while(connect_thread.joinable()) {
+		// the previous connect is joined outside of the lock (it might call wait() itself)
+		std::thread previous_thread;
+		previous_thread.swap(connect_thread);
+		connector_lock.unlock();
+		previous_thread.join();
+		connector_lock.lock();
+	}
+	connect_thread = std::thread([connect_promise, connect]() {
+		try {
+			connect_promise->set_value(connect());
+		} catch (...) {
+			connect_promise->set_exception(std::current_exception());
+		}
+	});
+	return connect_future;
+}
+
+void AsyncConnector::wait()
+{
+	std::thread pending_thread;
+	{
+		std::unique_lock<std::mutex> connector_lock(connector_mutex);
+		if(connect_thread.joinable() && connect_thread.get_id() == std::this_thread::get_id()) {
+			// called from within the connect function
+			return;
+		}
+		pending_thread.swap(connect_thread);
+	}
+	if(pending_thread.joinable()) {
+		pending_thread.join();
+	}
+}
+
+} /* namespace SmartDDS */
@@ -0,0 +1,91 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_ASYNCCONNECTOR_H_
+#define RTIDDSSMARTSOFT_ASYNCCONNECTOR_H_
+
+#include <mutex>
+#include <future>
+#include <thread>
+#include <functional>
+
+#include <smartStatusCode.h>
+
+namespace SmartDDS {
+
+/** Runs the connect(server, service) call of a client pattern in the background (see connectAsync).
+ *
+ *  The pending connect is tracked so that the client pattern can wait for it before it
+ *  disconnects or is destroyed (i.e. the background thread never outlives the pattern).
+ */
+class AsyncConnector {
+private:
+	std::mutex connector_mutex;
+	std::thread connect_thread;
+
+	// this class is not supposed to be copied
+	AsyncConnector(const AsyncConnector&) = delete;
+	AsyncConnector& operator=(const AsyncConnector&) = delete;
+
+public:
+	AsyncConnector() = default;
+	virtual ~AsyncConnector();
+
+	/** starts the given connect function in a background thread
+	 *
+	 *  A still pending connect of a previous call is completed first.
+	 *
+	 * @return a future providing the status code of the connect function
+	 */
+	std::future<Smart::StatusCode> start(const std::function<Smart::StatusCode()> &connect);
+
+	/** blocks until the pending connect (if any) has completed
+	 *
+	 *  Returns immediately if called from within the connect function itself
+	 *  (e.g. if connect(...) internally calls disconnect()).
+	 */
+	void wait();
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_ASYNCCONNECTOR_H_ */
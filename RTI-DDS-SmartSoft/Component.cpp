@@ -58,10 +58,12 @@ void handle_signal (int signal)
 	signal_cond_var.notify_all();
 }
 
-Component::Component(const std::string &componentName, const int domainId)
+Component::Component(const std::string &componentName, const int domainId, const DDSTransport transport)
 :	Smart::IComponent(componentName)
 ,	timerManager()
-,	dds_infrastructure(domainId)
+,	dds_infrastructure(domainId, componentName, transport)
+,	connection_timeout(std::chrono::seconds(1))
+,	local_dispatcher_pool(std::make_shared<LocalDispatcherPool>())
 {
 	cancelled = false;
 	std::signal(SIGINT, handle_signal);
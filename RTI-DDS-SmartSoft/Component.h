@@ -47,6 +47,7 @@
 
 #include "RTI-DDS-SmartSoft/TimerManagerThread.h"
 #include "RTI-DDS-SmartSoft/DDSInfrastructure.h"
+#include "RTI-DDS-SmartSoft/LocalServiceRegistry.h"
 
 namespace SmartDDS {
 
@@ -56,6 +57,11 @@ private:
 
 	DDSInfrastructure dds_infrastructure;
 
+	Smart::Duration connection_timeout;
+
+	// the threads of the local (in-process) deliveries of all patterns of this component (see LocalServiceRegistry)
+	std::shared_ptr<LocalDispatcherPool> local_dispatcher_pool;
+
 	// at least a component name needs to be provided so we delete the default constructor
 	Component() = delete;
 
@@ -68,8 +74,10 @@ public:
 	 *
 	 *   @param componentName  unique name of the whole component, which is used by the clients to
 	 *                         address this server
+	 *   @param domainId       the DDS domain of the component
+	 *   @param transport      the built-in transports used by the component (by default as defined by the QoS profiles)
 	 */
-	Component(const std::string &componentName, const int domainId = 0);
+	Component(const std::string &componentName, const int domainId = 0, const DDSTransport transport = DDSTransport::Default);
 
 	/** Destructor.
 	 *
@@ -81,6 +89,27 @@ public:
 		return dds_infrastructure;
 	}
 
+	/** Sets the maximal time the client patterns of this component wait for the
+	 *  remote end-point during connect() (the default is one second).
+	 *
+	 *  The timeout is a per-component setting, i.e. it applies to each connect() and
+	 *  connectAsync() call of all client patterns of this component (there is no timeout
+	 *  per call). Please set the timeout before connecting the client patterns.
+	 */
+	inline void setConnectionTimeout(const Smart::Duration &timeout) {
+		connection_timeout = timeout;
+	}
+	inline Smart::Duration getConnectionTimeout() const {
+		return connection_timeout;
+	}
+
+	/** The threads that call the handlers and observers of the local (in-process) connections
+	 *  of this component (they are shared by all patterns of this component).
+	 */
+	inline const std::shared_ptr<LocalDispatcherPool>& getLocalDispatcherPool() const {
+		return local_dispatcher_pool;
+	}
+
 
 	/** Runs the SmartSoft framework within a component which includes handling
 	 *  intercomponent communication etc. This method is called in the main()-routine
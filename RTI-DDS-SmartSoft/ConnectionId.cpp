@@ -41,6 +41,8 @@
 //===================================================================================
 
 #include <sstream>
+#include <mutex>
+#include <random>
 #include "RTI-DDS-SmartSoft/ConnectionId.h"
 
 namespace SmartDDS {
@@ -73,13 +75,20 @@ ConnectionId::ConnectionId(const std::vector<uint8_t> &vector_id)
 	}
 }
 
-ConnectionId::ConnectionId(const DynamicDataReader &related_reader)
+ConnectionId ConnectionId::createUnique()
 {
-	connection_id = related_reader.qos().policy<rti::core::policy::DataReaderProtocol>().virtual_guid();
-}
-ConnectionId::ConnectionId(const DynamicDataWriter &related_writer)
-{
-	connection_id = related_writer.qos().policy<rti::core::policy::DataWriterProtocol>().virtual_guid();
+	static std::mutex random_mutex;
+	static std::mt19937_64 random_engine(std::random_device{}());
+	std::unique_lock<std::mutex> random_lock(random_mutex);
+
+	rti::core::Guid guid;
+	for(size_t i=0; i<rti::core::Guid::LENGTH; i+=8) {
+		auto random_value = random_engine();
+		for(size_t j=0; j<8 && i+j<rti::core::Guid::LENGTH; ++j) {
+			guid[i+j] = static_cast<uint8_t>(random_value >> (8*j));
+		}
+	}
+	return ConnectionId(guid);
 }
 
 ConnectionId::operator const rti::core::Guid&() const
@@ -107,12 +116,14 @@ bool ConnectionId::operator!=(const ConnectionId &other) const
 
 std::string ConnectionId::toString() const
 {
-	std::stringstream connection_id_ss;
-	connection_id_ss << std::hex;
+	// this method is used to build the names of filtered topics, so we avoid using a stringstream
+	static const char hex_digits[] = "0123456789abcdef";
+	std::string connection_id_str(2*rti::core::Guid::LENGTH, '0');
 	for(size_t i=0; i<rti::core::Guid::LENGTH; ++i) {
-		connection_id_ss << std::setw(2) << std::setfill('0') << (int)connection_id[i];
+		connection_id_str[2*i] = hex_digits[(connection_id[i] >> 4) & 0x0F];
+		connection_id_str[2*i+1] = hex_digits[connection_id[i] & 0x0F];
 	}
-	return connection_id_ss.str();
+	return connection_id_str;
 }
 
 std::vector<uint8_t> ConnectionId::toVector() const
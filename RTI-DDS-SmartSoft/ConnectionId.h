@@ -60,9 +60,18 @@ public:
 	ConnectionId(const std::string &string_id);
 	ConnectionId(const std::vector<uint8_t> &vector_id);
 
+	// creates a random ID for connections that need an ID before their reader/writer exists
+	static ConnectionId createUnique();
+
 	// initiate connection from the related reader/writer
-	ConnectionId(const DynamicDataReader &related_reader);
-	ConnectionId(const DynamicDataWriter &related_writer);
+	template <class SampleType>
+	ConnectionId(const DDSReader<SampleType> &related_reader)
+	:	connection_id(related_reader.qos().template policy<rti::core::policy::DataReaderProtocol>().virtual_guid())
+	{  }
+	template <class SampleType>
+	ConnectionId(const DDSWriter<SampleType> &related_writer)
+	:	connection_id(related_writer.qos().template policy<rti::core::policy::DataWriterProtocol>().virtual_guid())
+	{  }
 
 	// default copy/move constructors and assignment operators
 	ConnectionId(const ConnectionId&) = default;
@@ -45,6 +45,43 @@
 
 namespace SmartDDS {
 
+CorrelationKey::CorrelationKey()
+:	guid_prefix(0)
+,	guid_suffix(0)
+,	sequence_number(0)
+,	hash(0)
+{  }
+
+CorrelationKey::CorrelationKey(const rti::core::SampleIdentity &sample_identity)
+:	guid_prefix(0)
+,	guid_suffix(0)
+,	sequence_number(sample_identity.sequence_number().value())
+,	hash(0)
+{
+	const auto &guid = sample_identity.writer_guid();
+	for(size_t i=0; i<8; ++i) {
+		guid_prefix = (guid_prefix << 8) | guid[i];
+		guid_suffix = (guid_suffix << 8) | guid[8+i];
+	}
+	// the sequence numbers of one writer are consecutive, so all bits are mixed (splitmix64 finalizer)
+	uint64_t value = guid_prefix ^ (guid_suffix * 0x9E3779B97F4A7C15ULL) ^ static_cast<uint64_t>(sequence_number);
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+	value = value ^ (value >> 31);
+	hash = static_cast<size_t>(value);
+}
+
+size_t InstanceHandleHash::operator()(const dds::core::InstanceHandle &handle) const
+{
+	// FNV-1a over the 16 key-hash bytes
+	const auto &key_hash = handle->native().keyHash;
+	uint64_t value = 0xCBF29CE484222325ULL;
+	for(size_t i=0; i<16; ++i) {
+		value = (value ^ key_hash.value[i]) * 0x100000001B3ULL;
+	}
+	return static_cast<size_t>(value);
+}
+
 CorrelationId::CorrelationId()
 :	writer_handle(nullptr)
 ,	sample_id(rti::core::SampleIdentity::automatic())
@@ -86,6 +123,14 @@ const rti::core::SequenceNumber& CorrelationId::getSequenceNumber() const {
 	return sample_id.sequence_number();
 }
 
+CorrelationKey CorrelationId::getKey() const {
+	return CorrelationKey(sample_id);
+}
+
+CorrelationKey CorrelationId::getConnectionKey() const {
+	return CorrelationKey(rti::core::SampleIdentity(sample_id.writer_guid(), rti::core::SequenceNumber::zero()));
+}
+
 CorrelationId
 CorrelationId::operator++(int)
 {
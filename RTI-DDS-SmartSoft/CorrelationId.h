@@ -51,6 +51,39 @@
 
 namespace SmartDDS {
 
+/** The raw identity of a correlation id (i.e. the writer GUID and the sequence number)
+ *  together with its precomputed hash, used as key of the pattern-internal hash tables
+ *  (see CorrelationTable), so lookups neither compare via virtual calls nor dynamic_casts.
+ */
+struct CorrelationKey {
+	uint64_t guid_prefix;
+	uint64_t guid_suffix;
+	int64_t sequence_number;
+	size_t hash;
+
+	CorrelationKey();
+	CorrelationKey(const rti::core::SampleIdentity &sample_identity);
+
+	inline bool operator==(const CorrelationKey &other) const {
+		return hash == other.hash && sequence_number == other.sequence_number
+				&& guid_prefix == other.guid_prefix && guid_suffix == other.guid_suffix;
+	}
+	inline bool operator!=(const CorrelationKey &other) const {
+		return !(*this == other);
+	}
+};
+
+struct CorrelationKeyHash {
+	inline size_t operator()(const CorrelationKey &key) const {
+		return key.hash;
+	}
+};
+
+// hashes the key-hash of an instance handle (e.g. of the request writer of a query client)
+struct InstanceHandleHash {
+	size_t operator()(const dds::core::InstanceHandle &handle) const;
+};
+
 class CorrelationId : public Smart::ICorrelationId {
 private:
 	rti::core::SampleIdentity sample_id;
@@ -83,6 +116,10 @@ public:
 	const dds::core::InstanceHandle& getWriterHandle() const;
 	const rti::core::SequenceNumber& getSequenceNumber() const;
 
+	CorrelationKey getKey() const;
+	// the key of the requesting connection (i.e. the same for all ids of one writer)
+	CorrelationKey getConnectionKey() const;
+
 	// post increment operator
 	CorrelationId operator++(int);
 
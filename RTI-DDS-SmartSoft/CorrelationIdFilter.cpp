@@ -44,57 +44,99 @@
 
 namespace SmartDDS {
 
-std::string CorrelationIdFilter::DEFAULT_FILTER_NAME = "SmartDDS::Filter::CorrelationId";
+constexpr int64_t CompiledReaderData::NO_PRESCALE;
 
-dds::topic::Filter CorrelationIdFilter::createClientFilter(const ConnectionId &connection_id)
+std::string CorrelationIdFilterBase::DEFAULT_FILTER_NAME = "SmartDDS::Filter::CorrelationId";
+
+dds::topic::Filter CorrelationIdFilterBase::createClientFilter(const ConnectionId &connection_id, const std::string &filter_name)
 {
 	dds::topic::Filter filter(connection_id.toString());
-	filter->name(DEFAULT_FILTER_NAME);
+	filter->name(filter_name);
 	return filter;
 }
 
-CompiledReaderData& CorrelationIdFilter::compile(
+std::vector<std::string> CorrelationIdFilterBase::createSubscriptionParameters(const unsigned int &prescale, const std::chrono::nanoseconds &minimum_separation)
+{
+	std::vector<std::string> parameters;
+	parameters.push_back(std::to_string(prescale));
+	if(minimum_separation > std::chrono::nanoseconds::zero()) {
+		parameters.push_back(std::to_string(minimum_separation.count()));
+	}
+	return parameters;
+}
+
+CompiledReaderData& CorrelationIdFilterBase::compile_reader(
     const std::string& expression,
     const dds::core::StringSeq& parameters,
-    const dds::core::optional<dds::core::xtypes::DynamicType>& type_code,
-    const std::string& type_class_name,
 	CompiledReaderData *old_compile_data)
 {
-	std::unique_lock<std::shared_timed_mutex> writer_lock(writer_mutex);
-
-	CompiledReaderData reader_data;
+	std::unique_lock<std::mutex> readers_lock(readers_mutex);
 
-	// we extract the connection ID from the expression and initialize the sequence-counter to zero
-	reader_data.correlation_id = CorrelationId(ConnectionId(expression), rti::core::SequenceNumber::zero());
+	if(old_compile_data == nullptr) {
+		// the compile data contains atomic counters, so it is constructed in place
+		compiled_readers.emplace_front();
+		old_compile_data = &compiled_readers.front();
+		old_compile_data->self_index = compiled_readers.begin();
+		// we extract the connection ID from the expression and initialize the sequence-counter to zero
+		old_compile_data->correlation_id = CorrelationId(ConnectionId(expression), rti::core::SequenceNumber::zero());
+	}
+	// otherwise, the filter parameters of an existing reader have been changed, in which
+	// case the existing compile data is updated in place (the reader remains connected)
+	CompiledReaderData &reader_data = *old_compile_data;
 
 	// extract the optional prescale factor from the parameters list
+	int64_t prescale_factor = CompiledReaderData::NO_PRESCALE;
 	if(parameters.size() > 0) {
-		std::stringstream ss_id(parameters[0]);
-		int prescale_factor = 0;
-		ss_id >> prescale_factor;
-		if(prescale_factor > 0) {
-			reader_data.prescale_factor = rti::core::SequenceNumber(prescale_factor);
+		std::stringstream ss_prescale(parameters[0]);
+		prescale_factor = 0;
+		ss_prescale >> prescale_factor;
+		if(prescale_factor < 0) {
+			prescale_factor = 0;
 		}
 	}
+	// extract the optional minimal time between two samples (used for rate-based subscriptions)
+	int64_t minimum_separation = 0;
+	if(parameters.size() > 1) {
+		std::stringstream ss_separation(parameters[1]);
+		ss_separation >> minimum_separation;
+	}
+
+	// a changed subscription again starts with the next available update
+	reader_data.update_counter = 0;
+	reader_data.last_pass_time = 0;
+	reader_data.minimum_separation = minimum_separation;
+	reader_data.prescale_factor = prescale_factor;
 
-	compiled_readers.push_front(reader_data);
-	compiled_readers.front().self_index = compiled_readers.begin();
-	return compiled_readers.front();
+	return reader_data;
 }
 
-bool CorrelationIdFilter::evaluate(
+bool CorrelationIdFilterBase::evaluate_reader(
 	CompiledReaderData& compile_data,
-    const DynamicDataSample& sample,
     const rti::topic::FilterSampleInfo& meta_data)
 {
-	std::unique_lock<std::shared_timed_mutex> writer_lock(writer_mutex);
-	if(compile_data.prescale_factor != rti::core::SequenceNumber::unknown()) {
-		auto current_update_value = compile_data.correlation_id.getSequenceNumber().value();
+	// no lock is needed here as only the reader's own (atomic) update counter is modified
+	auto prescale_factor = compile_data.prescale_factor.load(std::memory_order_relaxed);
+	if(prescale_factor == 0) {
+		// the subscription is paused
+		return false;
+	} else if(prescale_factor != CompiledReaderData::NO_PRESCALE) {
 		// increment the reader's update counter
-		compile_data.correlation_id++;
-		if(current_update_value % compile_data.prescale_factor.value() == 0) {
-			return true;
+		auto current_update_value = compile_data.update_counter.fetch_add(1, std::memory_order_relaxed);
+		if(current_update_value % prescale_factor != 0) {
+			return false;
+		}
+		auto minimum_separation = compile_data.minimum_separation.load(std::memory_order_relaxed);
+		if(minimum_separation > 0) {
+			// the filter is evaluated at the writer side, so the current time is the time of writing
+			int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count();
+			int64_t last_pass_time = compile_data.last_pass_time.load(std::memory_order_relaxed);
+			if(now - last_pass_time < minimum_separation) {
+				return false;
+			}
+			return compile_data.last_pass_time.compare_exchange_strong(last_pass_time, now, std::memory_order_relaxed);
 		}
+		return true;
 	} else {
 		// no prescale factor has been defined so we use the related sample ID to pass this sample
 		// only to the related client connection
@@ -105,9 +147,9 @@ bool CorrelationIdFilter::evaluate(
 	return false;
 }
 
-void CorrelationIdFilter::finalize(CompiledReaderData& compile_data)
+void CorrelationIdFilterBase::finalize_reader(CompiledReaderData& compile_data)
 {
-	std::unique_lock<std::shared_timed_mutex> writer_lock(writer_mutex);
+	std::unique_lock<std::mutex> readers_lock(readers_mutex);
 	compiled_readers.erase(compile_data.self_index);
 }
 
@@ -44,8 +44,11 @@
 #define CORRELATIONIDFILTER_H_
 
 #include <list>
+#include <mutex>
+#include <atomic>
+#include <chrono>
 #include <vector>
-#include <shared_mutex>
+#include <type_traits>
 
 #include "RTI-DDS-SmartSoft/DDSAliases.h"
 #include "RTI-DDS-SmartSoft/CorrelationId.h"
@@ -55,33 +58,91 @@ namespace SmartDDS {
 struct CompiledReaderData {
 	std::list<CompiledReaderData>::iterator self_index;
 	CorrelationId correlation_id;
-	rti::core::SequenceNumber prescale_factor = rti::core::SequenceNumber::unknown();
+	// the subscription parameters are atomic as they can be changed (i.e. recompiled) while samples are evaluated
+	// a prescale factor of zero pauses the subscription and NO_PRESCALE selects the related-sample filtering
+	static constexpr int64_t NO_PRESCALE = -1;
+	std::atomic<int64_t> prescale_factor { NO_PRESCALE };
+	// optional minimal time (in nanoseconds of the steady clock) between two samples passed to the reader
+	std::atomic<int64_t> minimum_separation { 0 };
+	// each reader counts its updates individually, so evaluating different readers never contends
+	std::atomic<uint64_t> update_counter { 0 };
+	std::atomic<int64_t> last_pass_time { 0 };
 };
 
-class CorrelationIdFilter
-:	public rti::topic::ContentFilter<DynamicDataSample, CompiledReaderData>
-{
+/** Implements the sample-type independent filter logic.
+ *
+ *  The filter only evaluates the sample's meta-data (i.e. the related sample identity),
+ *  so the same logic is shared by the DynamicData filter and the filters registered for
+ *  IDL-generated types (see CorrelationIdFilter below).
+ */
+class CorrelationIdFilterBase {
 public:
-	virtual ~CorrelationIdFilter() = default;
+	virtual ~CorrelationIdFilterBase() = default;
 	static std::string DEFAULT_FILTER_NAME;
-	static dds::topic::Filter createClientFilter(const ConnectionId &connection_id);
+	static dds::topic::Filter createClientFilter(const ConnectionId &connection_id, const std::string &filter_name = DEFAULT_FILTER_NAME);
+
+	// creates the filter parameters of a subscription (i.e. a prescale factor and an optional minimal time between two samples),
+	// these parameters can be changed at any time using the filter_parameters(...) of the client's filtered topic,
+	// where a prescale factor of zero pauses the subscription (i.e. no samples are passed)
+	static std::vector<std::string> createSubscriptionParameters(const unsigned int &prescale,
+			const std::chrono::nanoseconds &minimum_separation = std::chrono::nanoseconds::zero());
+
+	// the DynamicData filter uses the default filter name, each IDL-generated type registers an own filter instance
+	template <class SampleType>
+	static std::string getFilterName() {
+		if(std::is_same<SampleType, DynamicDataSample>::value) {
+			return DEFAULT_FILTER_NAME;
+		}
+		return DEFAULT_FILTER_NAME + "::" + dds::topic::topic_type_name<SampleType>::value();
+	}
+protected:
+	CompiledReaderData& compile_reader(
+		const std::string& expression,
+		const dds::core::StringSeq& parameters,
+		CompiledReaderData *old_compile_data);
+
+	bool evaluate_reader(
+		CompiledReaderData& compile_data,
+		const rti::topic::FilterSampleInfo& meta_data);
+
+	void finalize_reader(CompiledReaderData& compile_data);
 private:
-	mutable std::shared_timed_mutex writer_mutex;
+	// the mutex only protects the list of compiled readers (i.e. compile and finalize),
+	// the per-sample evaluation only accesses the reader's own compile data
+	std::mutex readers_mutex;
 	std::list<CompiledReaderData> compiled_readers;
+};
 
+template <class SampleType = DynamicDataSample>
+class CorrelationIdFilter
+:	public rti::topic::ContentFilter<SampleType, CompiledReaderData>
+,	public CorrelationIdFilterBase
+{
+public:
+	virtual ~CorrelationIdFilter() = default;
+private:
     virtual CompiledReaderData& compile(
         const std::string& expression,
         const dds::core::StringSeq& parameters,
         const dds::core::optional<dds::core::xtypes::DynamicType>& type_code,
         const std::string& type_class_name,
-		CompiledReaderData *old_compile_data) override;
+		CompiledReaderData *old_compile_data) override
+    {
+    	return compile_reader(expression, parameters, old_compile_data);
+    }
 
     virtual bool evaluate(
     	CompiledReaderData& compile_data,
-        const DynamicDataSample& sample,
-        const rti::topic::FilterSampleInfo& meta_data) override;
+        const SampleType& sample,
+        const rti::topic::FilterSampleInfo& meta_data) override
+    {
+    	return evaluate_reader(compile_data, meta_data);
+    }
 
-    virtual void finalize(CompiledReaderData& compile_data) override;
+    virtual void finalize(CompiledReaderData& compile_data) override
+    {
+    	finalize_reader(compile_data);
+    }
 };
 
 } /* namespace SmartDDS */
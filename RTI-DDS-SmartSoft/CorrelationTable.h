@@ -0,0 +1,216 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_CORRELATIONTABLE_H_
+#define RTIDDSSMARTSOFT_CORRELATIONTABLE_H_
+
+#include <array>
+#include <mutex>
+#include <vector>
+#include <utility>
+
+#include "RTI-DDS-SmartSoft/CorrelationId.h"
+
+namespace SmartDDS {
+
+/** A hash table keyed by CorrelationKey, e.g. for the pending queries of a QueryClientPattern.
+ *
+ *  The entries are distributed over several shards (by the precomputed hash of the key), each
+ *  of which has its own mutex, so concurrent requests, answers and receive calls for different
+ *  queries rarely contend on the same lock. Each shard is an open-addressing table with linear
+ *  probing (and backward-shift deletion), so neither lookups nor insertions allocate memory
+ *  unless a shard has to grow.
+ */
+template <class ValueType>
+class CorrelationTable {
+private:
+	static constexpr size_t SHARD_COUNT = 16;
+	static constexpr size_t SHARD_BITS = 4;
+	static constexpr size_t INITIAL_CAPACITY = 16;
+
+	struct Slot {
+		bool used = false;
+		CorrelationKey key;
+		ValueType value;
+	};
+	struct Shard {
+		std::mutex shard_mutex;
+		std::vector<Slot> slots;
+		size_t size = 0;
+	};
+	std::array<Shard, SHARD_COUNT> shards;
+
+	inline Shard& get_shard(const CorrelationKey &key) {
+		return shards[key.hash & (SHARD_COUNT-1)];
+	}
+	static inline size_t home_slot(const Shard &shard, const CorrelationKey &key) {
+		// the lower bits select the shard, so the slot is selected by the remaining bits
+		return (key.hash >> SHARD_BITS) & (shard.slots.size()-1);
+	}
+
+	// returns the index of the key's slot (or of the free slot where it would be inserted)
+	static size_t find_slot(const Shard &shard, const CorrelationKey &key) {
+		auto mask = shard.slots.size()-1;
+		auto index = home_slot(shard, key);
+		while(shard.slots[index].used && shard.slots[index].key != key) {
+			index = (index + 1) & mask;
+		}
+		return index;
+	}
+
+	static void grow(Shard &shard) {
+		std::vector<Slot> old_slots(shard.slots.empty() ? INITIAL_CAPACITY : 2*shard.slots.size());
+		old_slots.swap(shard.slots);
+		for(auto &slot: old_slots) {
+			if(slot.used) {
+				auto &new_slot = shard.slots[find_slot(shard, slot.key)];
+				new_slot.used = true;
+				new_slot.key = slot.key;
+				new_slot.value = std::move(slot.value);
+			}
+		}
+	}
+
+	static void erase_slot(Shard &shard, size_t index) {
+		auto mask = shard.slots.size()-1;
+		auto next = index;
+		while(true) {
+			next = (next + 1) & mask;
+			if(!shard.slots[next].used)
+				break;
+			// an entry can only be moved back if its home slot does not lie cyclically within (index, next]
+			auto home = home_slot(shard, shard.slots[next].key);
+			bool stays = (index <= next) ? (index < home && home <= next) : (index < home || home <= next);
+			if(stays)
+				continue;
+			shard.slots[index].key = shard.slots[next].key;
+			shard.slots[index].value = std::move(shard.slots[next].value);
+			index = next;
+		}
+		shard.slots[index].used = false;
+		shard.slots[index].value = ValueType();
+		shard.size--;
+	}
+
+public:
+	CorrelationTable() = default;
+
+	/// inserts (or replaces) the value of the given key
+	void insert(const CorrelationKey &key, const ValueType &value) {
+		auto &shard = get_shard(key);
+		std::unique_lock<std::mutex> shard_lock(shard.shard_mutex);
+		// the load factor is kept at or below one half
+		if(2*(shard.size+1) > shard.slots.size()) {
+			grow(shard);
+		}
+		auto &slot = shard.slots[find_slot(shard, key)];
+		if(!slot.used) {
+			slot.used = true;
+			slot.key = key;
+			shard.size++;
+		}
+		slot.value = value;
+	}
+
+	/// copies the value of the given key (returns false if the key is unknown)
+	bool find(const CorrelationKey &key, ValueType &value) {
+		auto &shard = get_shard(key);
+		std::unique_lock<std::mutex> shard_lock(shard.shard_mutex);
+		if(shard.size == 0)
+			return false;
+		auto &slot = shard.slots[find_slot(shard, key)];
+		if(!slot.used)
+			return false;
+		value = slot.value;
+		return true;
+	}
+
+	/// removes the given key (returns false if the key is unknown)
+	bool erase(const CorrelationKey &key) {
+		ValueType value;
+		return take(key, value);
+	}
+
+	/// removes the given key and moves its value into the provided reference (returns false if the key is unknown)
+	bool take(const CorrelationKey &key, ValueType &value) {
+		auto &shard = get_shard(key);
+		std::unique_lock<std::mutex> shard_lock(shard.shard_mutex);
+		if(shard.size == 0)
+			return false;
+		auto index = find_slot(shard, key);
+		if(!shard.slots[index].used)
+			return false;
+		value = std::move(shard.slots[index].value);
+		erase_slot(shard, index);
+		return true;
+	}
+
+	/// removes all entries and returns their values
+	std::vector<ValueType> takeAll() {
+		std::vector<ValueType> values;
+		for(auto &shard: shards) {
+			std::unique_lock<std::mutex> shard_lock(shard.shard_mutex);
+			for(auto &slot: shard.slots) {
+				if(slot.used) {
+					values.push_back(std::move(slot.value));
+					slot.value = ValueType();
+					slot.used = false;
+				}
+			}
+			shard.size = 0;
+		}
+		return values;
+	}
+
+	size_t size() {
+		size_t total_size = 0;
+		for(auto &shard: shards) {
+			std::unique_lock<std::mutex> shard_lock(shard.shard_mutex);
+			total_size += shard.size;
+		}
+		return total_size;
+	}
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_CORRELATIONTABLE_H_ */
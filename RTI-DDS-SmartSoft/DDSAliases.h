@@ -65,6 +65,22 @@ using LivelinessChangedStatus = dds::core::status::LivelinessChangedStatus;
 // this is the default compile data definition for filtered topics
 using NoCompileData = rti::topic::no_compile_data_t;
 
+// generic aliases used by the patterns, the SampleType is either DynamicData or an IDL-generated type (see DDSTypeTraits.h)
+template <class SampleType>
+using DDSTopic = dds::topic::Topic<SampleType>;
+template <class SampleType>
+using DDSFilteredTopic = dds::topic::ContentFilteredTopic<SampleType>;
+
+template <class SampleType>
+using DDSWriter = dds::pub::DataWriter<SampleType>;
+template <class SampleType>
+using DDSWriterListener = dds::pub::NoOpDataWriterListener<SampleType>;
+
+template <class SampleType>
+using DDSReader = dds::sub::DataReader<SampleType>;
+template <class SampleType>
+using DDSReaderListener = dds::sub::NoOpDataReaderListener<SampleType>;
+
 } /* namespace SmartDDS */
 
 #endif /* RTIDDSSMARTSOFT_DDSALIASES_H_ */
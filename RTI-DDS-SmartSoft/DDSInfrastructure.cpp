@@ -44,16 +44,26 @@
 
 namespace SmartDDS {
 
-DDSInfrastructure::DDSInfrastructure(const int domain_id)
-:	domain_participant(domain_id)
-,	correlationid_filter(new CorrelationIdFilter())
+DDSInfrastructure::DDSInfrastructure(const int domain_id, const std::string &component_name, const DDSTransport &transport)
+:	domain_participant(domain_id, DDSQosProfiles::getParticipantQos(component_name, transport))
+,	correlationid_filter(new CorrelationIdFilter<DynamicDataSample>())
 {
-	domain_participant->register_contentfilter(correlationid_filter, CorrelationIdFilter::DEFAULT_FILTER_NAME);
+	domain_participant->register_contentfilter(correlationid_filter, CorrelationIdFilterBase::DEFAULT_FILTER_NAME);
 }
 
 DDSInfrastructure::~DDSInfrastructure()
 {
-	domain_participant->unregister_contentfilter(CorrelationIdFilter::DEFAULT_FILTER_NAME);
+	topic_cache.clear();
+	std::unique_lock<std::mutex> entities_lock(entities_mutex);
+	publishers.clear();
+	subscribers.clear();
+	flow_controllers.clear();
+	entities_lock.unlock();
+	for(const auto& typed_filter: typed_correlationid_filters) {
+		domain_participant->unregister_contentfilter(typed_filter.first);
+	}
+	typed_correlationid_filters.clear();
+	domain_participant->unregister_contentfilter(CorrelationIdFilterBase::DEFAULT_FILTER_NAME);
 	domain_participant.close();
 	dds::domain::DomainParticipant::finalize_participant_factory();
 }
@@ -63,47 +73,73 @@ const dds::domain::DomainParticipant& DDSInfrastructure::getDomainParticipant()
 	return domain_participant;
 }
 
-DynamicDataTopic DDSInfrastructure::findOrCreateTopic(
-			const std::string &topicName,
-			const DynamicStructType &dynamicType)
+int DDSInfrastructure::getDomainId() const
 {
-	std::unique_lock<std::mutex> scoped_lock(infrastructure_mutex);
-	auto dds_topic = dds::topic::find<DynamicDataTopic>(domain_participant, topicName);
-	if(dds_topic.is_nil()) {
-		dds_topic = DynamicDataTopic(domain_participant, topicName, dynamicType);
+	return domain_participant.domain_id();
+}
+
+dds::pub::Publisher DDSInfrastructure::getPublisher(const std::string &partition)
+{
+	std::unique_lock<std::mutex> entities_lock(entities_mutex);
+	auto publisher = publishers.find(partition);
+	if(publisher != publishers.end()) {
+		return publisher->second;
+	}
+	auto publisher_qos = domain_participant.default_publisher_qos();
+	if(!partition.empty()) {
+		publisher_qos << dds::core::policy::Partition(partition);
 	}
-	return dds_topic;
+	dds::pub::Publisher new_publisher(domain_participant, publisher_qos);
+	publishers.emplace(partition, new_publisher);
+	return new_publisher;
 }
 
-DynamicDataFilteredTopic DDSInfrastructure::findOrCreateClientFilteredTopic(
-			const DynamicDataTopic &parent_topic,
-			const ConnectionId &id, const std::string &filter_parameter)
+dds::sub::Subscriber DDSInfrastructure::getSubscriber(const std::string &partition)
 {
-	std::unique_lock<std::mutex> scoped_lock(infrastructure_mutex);
-	std::string cft_name = parent_topic.name() + "::Filtered_"+id.toString();
-	auto dds_topic = dds::topic::find<DynamicDataFilteredTopic>(parent_topic.participant(), cft_name);
-	if(dds_topic.is_nil()) {
-		auto filter = CorrelationIdFilter::createClientFilter(id);
-		if(filter_parameter != "") {
-			filter.add_parameter(filter_parameter);
-		}
-		dds_topic = DynamicDataFilteredTopic(parent_topic, cft_name, filter);
+	std::unique_lock<std::mutex> entities_lock(entities_mutex);
+	auto subscriber = subscribers.find(partition);
+	if(subscriber != subscribers.end()) {
+		return subscriber->second;
+	}
+	auto subscriber_qos = domain_participant.default_subscriber_qos();
+	if(!partition.empty()) {
+		subscriber_qos << dds::core::policy::Partition(partition);
 	}
-	return dds_topic;
+	dds::sub::Subscriber new_subscriber(domain_participant, subscriber_qos);
+	subscribers.emplace(partition, new_subscriber);
+	return new_subscriber;
 }
 
-void DDSInfrastructure::resetTopic(DynamicDataTopic &topic)
+bool DDSInfrastructure::findOrCreateFlowController(const std::string &name, const rti::pub::FlowControllerProperty &property)
 {
-	std::unique_lock<std::mutex> scoped_lock(infrastructure_mutex);
-	// reset the topic reference
-	topic = nullptr;
+	std::unique_lock<std::mutex> entities_lock(entities_mutex);
+	auto flow_controller = flow_controllers.find(name);
+	if(flow_controller == flow_controllers.end()) {
+		flow_controllers.emplace(name, rti::pub::FlowController(domain_participant, name, property));
+		return true;
+	}
+	auto existing_property = flow_controller->second.property();
+	auto existing_bucket = existing_property.token_bucket();
+	auto token_bucket = property.token_bucket();
+	return existing_property.scheduling_policy() == property.scheduling_policy()
+			&& existing_bucket.max_tokens() == token_bucket.max_tokens()
+			&& existing_bucket.tokens_added_per_period() == token_bucket.tokens_added_per_period()
+			&& existing_bucket.tokens_leaked_per_period() == token_bucket.tokens_leaked_per_period()
+			&& existing_bucket.period() == token_bucket.period()
+			&& existing_bucket.bytes_per_token() == token_bucket.bytes_per_token();
 }
 
-void DDSInfrastructure::resetFilteredTopic(DynamicDataFilteredTopic &filtered_topic)
+DynamicDataTopic DDSInfrastructure::findOrCreateTopic(
+			const std::string &topicName,
+			const DynamicStructType &dynamicType)
 {
-	std::unique_lock<std::mutex> scoped_lock(infrastructure_mutex);
-	// reset the topic reference
-	filtered_topic = nullptr;
+	return topic_cache.acquire<DynamicDataTopic>(topicName, [&]() {
+		auto dds_topic = dds::topic::find<DynamicDataTopic>(domain_participant, topicName);
+		if(dds_topic.is_nil()) {
+			dds_topic = DynamicDataTopic(domain_participant, topicName, dynamicType);
+		}
+		return dds_topic;
+	});
 }
 
 } /* namespace SmartDDS */
@@ -44,11 +44,16 @@
 #define RTIDDSSMARTSOFT_DDSINFRASTRUCTURE_H_
 
 #include <map>
+#include <mutex>
+#include <memory>
+#include <type_traits>
 
 #include <dds/dds.hpp>
 
 #include "RTI-DDS-SmartSoft/ConnectionId.h"
 #include "RTI-DDS-SmartSoft/CorrelationIdFilter.h"
+#include "RTI-DDS-SmartSoft/DDSTopicCache.h"
+#include "RTI-DDS-SmartSoft/DDSQosProfiles.h"
 
 namespace SmartDDS {
 
@@ -56,10 +61,37 @@ class DDSInfrastructure {
 private:
 	std::mutex infrastructure_mutex;
 	dds::domain::DomainParticipant domain_participant;
-	rti::topic::CustomFilter<CorrelationIdFilter> correlationid_filter;
+	rti::topic::CustomFilter<CorrelationIdFilter<DynamicDataSample>> correlationid_filter;
+
+	// the topic handles are cached by name so (re-)connecting patterns neither lock the whole
+	// infrastructure nor search the participant for already created topics
+	DDSTopicCache topic_cache;
+
+	// all readers and writers of a component share the publishers and subscribers (one per partition)
+	std::mutex entities_mutex;
+	std::map<std::string, dds::pub::Publisher> publishers;
+	std::map<std::string, dds::sub::Subscriber> subscribers;
+	std::map<std::string, rti::pub::FlowController> flow_controllers;
+
+	// the correlation-id filters for IDL-generated types are registered on demand (one filter per type)
+	std::map<std::string, std::shared_ptr<void>> typed_correlationid_filters;
+
+	template <class SampleType>
+	std::string registerCorrelationIdFilter()
+	{
+		auto filter_name = CorrelationIdFilterBase::getFilterName<SampleType>();
+		if(!std::is_same<SampleType, DynamicDataSample>::value
+				&& typed_correlationid_filters.find(filter_name) == typed_correlationid_filters.end())
+		{
+			auto typed_filter = std::make_shared<rti::topic::CustomFilter<CorrelationIdFilter<SampleType>>>(new CorrelationIdFilter<SampleType>());
+			domain_participant->register_contentfilter(*typed_filter, filter_name);
+			typed_correlationid_filters[filter_name] = typed_filter;
+		}
+		return filter_name;
+	}
 
 public:
-	DDSInfrastructure(const int domain_id = 0);
+	DDSInfrastructure(const int domain_id = 0, const std::string &component_name = "", const DDSTransport &transport = DDSTransport::Default);
 	virtual ~DDSInfrastructure();
 
 	/** get shared domain participant reference
@@ -67,16 +99,89 @@ public:
 	 */
 	const dds::domain::DomainParticipant& getDomainParticipant() const;
 
+	// the DDS domain ID of the domain participant
+	int getDomainId() const;
+
+	/** get the shared publisher for the given partition (it is created on first use)
+	 * @param partition the partition name (the default partition is used if empty)
+	 */
+	dds::pub::Publisher getPublisher(const std::string &partition = "");
+
+	/** get the shared subscriber for the given partition (it is created on first use)
+	 * @param partition the partition name (the default partition is used if empty)
+	 */
+	dds::sub::Subscriber getSubscriber(const std::string &partition = "");
+
+	/** creates a named flow controller for asynchronously publishing writers (if it does not yet exist)
+	 *
+	 *  An already existing flow controller with the same name is kept unchanged.
+	 *  @return false if the existing flow controller has different properties
+	 */
+	bool findOrCreateFlowController(const std::string &name, const rti::pub::FlowControllerProperty &property);
+
 	DynamicDataTopic findOrCreateTopic(
 				const std::string &topicName,
 				const DynamicStructType &dynamicType);
 
-	DynamicDataFilteredTopic findOrCreateClientFilteredTopic(
-				const DynamicDataTopic &parent_topic,
-				const ConnectionId &id, const std::string &filter_parameter = "");
+	/** find or create a topic for an IDL-generated type (the type is registered implicitly)
+	 */
+	template <class SampleType>
+	DDSTopic<SampleType> findOrCreateTopic(const std::string &topicName)
+	{
+		return topic_cache.acquire<DDSTopic<SampleType>>(topicName, [&]() {
+			auto dds_topic = dds::topic::find<DDSTopic<SampleType>>(domain_participant, topicName);
+			if(dds_topic.is_nil()) {
+				dds_topic = DDSTopic<SampleType>(domain_participant, topicName);
+			}
+			return dds_topic;
+		});
+	}
+
+	template <class SampleType>
+	DDSFilteredTopic<SampleType> findOrCreateClientFilteredTopic(
+				const DDSTopic<SampleType> &parent_topic,
+				const ConnectionId &id, const std::vector<std::string> &filter_parameters = {})
+	{
+		std::string cft_name = parent_topic.name() + "::Filtered_"+id.toString();
+		return topic_cache.acquire<DDSFilteredTopic<SampleType>>(cft_name, [&]() {
+			auto dds_topic = dds::topic::find<DDSFilteredTopic<SampleType>>(parent_topic.participant(), cft_name);
+			if(dds_topic.is_nil()) {
+				std::unique_lock<std::mutex> scoped_lock(infrastructure_mutex);
+				auto filter_name = registerCorrelationIdFilter<SampleType>();
+				scoped_lock.unlock();
+				auto filter = CorrelationIdFilterBase::createClientFilter(id, filter_name);
+				for(const auto &filter_parameter: filter_parameters) {
+					filter.add_parameter(filter_parameter);
+				}
+				dds_topic = DDSFilteredTopic<SampleType>(parent_topic, cft_name, filter);
+			}
+			return dds_topic;
+		});
+	}
+
+	/** releases a topic acquired by findOrCreateTopic (the last user drops the topic from the cache)
+	 */
+	template <class SampleType>
+	void resetTopic(DDSTopic<SampleType> &topic)
+	{
+		if(!topic.is_nil()) {
+			topic_cache.release<DDSTopic<SampleType>>(topic.name());
+		}
+		// reset the topic reference
+		topic = nullptr;
+	}
 
-	void resetTopic(DynamicDataTopic &topic);
-	void resetFilteredTopic(DynamicDataFilteredTopic &topic);
+	/** releases a filtered topic acquired by findOrCreateClientFilteredTopic (the last user drops the topic from the cache)
+	 */
+	template <class SampleType>
+	void resetFilteredTopic(DDSFilteredTopic<SampleType> &filtered_topic)
+	{
+		if(!filtered_topic.is_nil()) {
+			topic_cache.release<DDSFilteredTopic<SampleType>>(filtered_topic.name());
+		}
+		// reset the topic reference
+		filtered_topic = nullptr;
+	}
 };
 
 } /* namespace SmartDDS */
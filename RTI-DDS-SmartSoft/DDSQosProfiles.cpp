@@ -0,0 +1,244 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#include "RTI-DDS-SmartSoft/DDSQosProfiles.h"
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <iostream>
+#include <algorithm>
+
+namespace SmartDDS {
+
+std::string DDSQosProfiles::LIBRARY_NAME = "SmartDDS";
+
+static std::mutex qos_provider_mutex;
+static std::unique_ptr<dds::core::QosProvider> custom_qos_provider;
+
+// the resolved profile names of the lookups (each lookup walks the profile libraries), guarded by the qos_provider_mutex
+static std::map<std::string, std::string> resolved_profiles;
+
+void DDSQosProfiles::setQosProvider(const std::string &uri)
+{
+	std::unique_lock<std::mutex> provider_lock(qos_provider_mutex);
+	custom_qos_provider.reset(new dds::core::QosProvider(uri));
+	resolved_profiles.clear();
+}
+
+dds::core::QosProvider DDSQosProfiles::getQosProvider()
+{
+	std::unique_lock<std::mutex> provider_lock(qos_provider_mutex);
+	if(custom_qos_provider) {
+		return *custom_qos_provider;
+	}
+	return dds::core::QosProvider::Default();
+}
+
+bool DDSQosProfiles::hasProfile(const std::string &profile_name)
+{
+	try {
+		auto provider = getQosProvider();
+		auto libraries = provider->qos_profile_libraries();
+		if(std::find(libraries.begin(), libraries.end(), LIBRARY_NAME) == libraries.end()) {
+			return false;
+		}
+		auto profiles = provider->qos_profiles(LIBRARY_NAME);
+		return std::find(profiles.begin(), profiles.end(), profile_name) != profiles.end();
+	} catch(dds::core::Error &error) {
+		std::cerr << error.what() << std::endl;
+	}
+	return false;
+}
+
+// a profile without the respective element results in the built-in default QoS
+bool DDSQosProfiles::definesReaderQos(const std::string &profile_name)
+{
+	try {
+		return getQosProvider().datareader_qos(LIBRARY_NAME+"::"+profile_name) != dds::sub::qos::DataReaderQos();
+	} catch(dds::core::Error &error) {
+		std::cerr << error.what() << std::endl;
+	}
+	return false;
+}
+
+bool DDSQosProfiles::definesWriterQos(const std::string &profile_name)
+{
+	try {
+		return getQosProvider().datawriter_qos(LIBRARY_NAME+"::"+profile_name) != dds::pub::qos::DataWriterQos();
+	} catch(dds::core::Error &error) {
+		std::cerr << error.what() << std::endl;
+	}
+	return false;
+}
+
+std::string DDSQosProfiles::findProfile(const std::string &entity_kind, const std::string &pattern_name, const std::string &component_name,
+		const std::string &server_name, const std::string &service_name)
+{
+	auto lookup_key = entity_kind+"|"+pattern_name+"|"+component_name+"|"+server_name+"."+service_name;
+	{
+		std::unique_lock<std::mutex> provider_lock(qos_provider_mutex);
+		auto resolved_profile = resolved_profiles.find(lookup_key);
+		if(resolved_profile != resolved_profiles.end()) {
+			return resolved_profile->second;
+		}
+	}
+
+	std::string profile;
+	// the profiles are checked from the most specific to the most general one
+	for(const auto &profile_name: {server_name+"."+service_name, component_name, pattern_name}) {
+		if(hasProfile(profile_name) && (entity_kind == "reader" ? definesReaderQos(profile_name) : definesWriterQos(profile_name))) {
+			profile = LIBRARY_NAME+"::"+profile_name;
+			break;
+		}
+	}
+
+	std::unique_lock<std::mutex> provider_lock(qos_provider_mutex);
+	resolved_profiles[lookup_key] = profile;
+	return profile;
+}
+
+std::string DDSQosProfiles::findReaderProfile(const std::string &pattern_name, const std::string &component_name,
+		const std::string &server_name, const std::string &service_name)
+{
+	return findProfile("reader", pattern_name, component_name, server_name, service_name);
+}
+
+std::string DDSQosProfiles::findWriterProfile(const std::string &pattern_name, const std::string &component_name,
+		const std::string &server_name, const std::string &service_name)
+{
+	return findProfile("writer", pattern_name, component_name, server_name, service_name);
+}
+
+// replaces the policy of the QoS if the profile sets it to a value other than RTI's default
+template <class Policy, class QosType>
+static void overlay_policy(QosType &qos, const QosType &profile_qos, const QosType &default_qos)
+{
+	const auto &profile_policy = profile_qos.template policy<Policy>();
+	if(profile_policy != default_qos.template policy<Policy>()) {
+		qos << profile_policy;
+	}
+}
+
+dds::sub::qos::DataReaderQos DDSQosProfiles::getReaderQos(const std::string &profile_name, const dds::sub::qos::DataReaderQos &builtin_qos)
+{
+	auto reader_qos = builtin_qos;
+	if(profile_name.empty()) {
+		return reader_qos;
+	}
+	auto profile_qos = getQosProvider().datareader_qos(profile_name);
+	const dds::sub::qos::DataReaderQos default_qos;
+
+	using namespace dds::core::policy;
+	overlay_policy<Durability>(reader_qos, profile_qos, default_qos);
+	overlay_policy<Deadline>(reader_qos, profile_qos, default_qos);
+	overlay_policy<LatencyBudget>(reader_qos, profile_qos, default_qos);
+	overlay_policy<Liveliness>(reader_qos, profile_qos, default_qos);
+	overlay_policy<Reliability>(reader_qos, profile_qos, default_qos);
+	overlay_policy<DestinationOrder>(reader_qos, profile_qos, default_qos);
+	overlay_policy<History>(reader_qos, profile_qos, default_qos);
+	overlay_policy<ResourceLimits>(reader_qos, profile_qos, default_qos);
+	overlay_policy<Ownership>(reader_qos, profile_qos, default_qos);
+	overlay_policy<TimeBasedFilter>(reader_qos, profile_qos, default_qos);
+	overlay_policy<ReaderDataLifecycle>(reader_qos, profile_qos, default_qos);
+	overlay_policy<rti::core::policy::DataReaderProtocol>(reader_qos, profile_qos, default_qos);
+	overlay_policy<rti::core::policy::DataReaderResourceLimits>(reader_qos, profile_qos, default_qos);
+	return reader_qos;
+}
+
+dds::pub::qos::DataWriterQos DDSQosProfiles::getWriterQos(const std::string &profile_name, const dds::pub::qos::DataWriterQos &builtin_qos)
+{
+	auto writer_qos = builtin_qos;
+	if(profile_name.empty()) {
+		return writer_qos;
+	}
+	auto profile_qos = getQosProvider().datawriter_qos(profile_name);
+	const dds::pub::qos::DataWriterQos default_qos;
+
+	using namespace dds::core::policy;
+	overlay_policy<Durability>(writer_qos, profile_qos, default_qos);
+	overlay_policy<Deadline>(writer_qos, profile_qos, default_qos);
+	overlay_policy<LatencyBudget>(writer_qos, profile_qos, default_qos);
+	overlay_policy<Liveliness>(writer_qos, profile_qos, default_qos);
+	overlay_policy<Reliability>(writer_qos, profile_qos, default_qos);
+	overlay_policy<DestinationOrder>(writer_qos, profile_qos, default_qos);
+	overlay_policy<History>(writer_qos, profile_qos, default_qos);
+	overlay_policy<ResourceLimits>(writer_qos, profile_qos, default_qos);
+	overlay_policy<TransportPriority>(writer_qos, profile_qos, default_qos);
+	overlay_policy<Lifespan>(writer_qos, profile_qos, default_qos);
+	overlay_policy<Ownership>(writer_qos, profile_qos, default_qos);
+	overlay_policy<OwnershipStrength>(writer_qos, profile_qos, default_qos);
+	overlay_policy<WriterDataLifecycle>(writer_qos, profile_qos, default_qos);
+	overlay_policy<rti::core::policy::DataWriterProtocol>(writer_qos, profile_qos, default_qos);
+	overlay_policy<rti::core::policy::DataWriterResourceLimits>(writer_qos, profile_qos, default_qos);
+	overlay_policy<rti::core::policy::PublishMode>(writer_qos, profile_qos, default_qos);
+	overlay_policy<rti::core::policy::Batch>(writer_qos, profile_qos, default_qos);
+	return writer_qos;
+}
+
+dds::domain::qos::DomainParticipantQos DDSQosProfiles::getParticipantQos(const std::string &component_name, const DDSTransport &transport)
+{
+	auto provider = getQosProvider();
+	auto participant_qos = provider.participant_qos();
+	if(!component_name.empty() && hasProfile(component_name)) {
+		participant_qos = provider.participant_qos(LIBRARY_NAME+"::"+component_name);
+	}
+
+	using rti::core::policy::TransportBuiltin;
+	using rti::core::policy::TransportBuiltinMask;
+	switch(transport) {
+	case DDSTransport::SharedMemory:
+		participant_qos << TransportBuiltin(TransportBuiltinMask::shmem());
+		break;
+	case DDSTransport::UDP:
+		participant_qos << TransportBuiltin(TransportBuiltinMask::udpv4());
+		break;
+	case DDSTransport::SharedMemoryAndUDP:
+		participant_qos << TransportBuiltin(TransportBuiltinMask::shmem() | TransportBuiltinMask::udpv4());
+		break;
+	default:
+		break;
+	}
+	return participant_qos;
+}
+
+} /* namespace SmartDDS */
@@ -0,0 +1,128 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_DDSQOSPROFILES_H_
+#define RTIDDSSMARTSOFT_DDSQOSPROFILES_H_
+
+#include <string>
+
+#include <dds/dds.hpp>
+
+namespace SmartDDS {
+
+/** The built-in transports used by the DDS participant of a component
+ */
+enum class DDSTransport {
+	// the transports are defined by the QoS profile (or the RTI defaults)
+	Default,
+	// only the shared-memory transport (i.e. all components run on the same host)
+	SharedMemory,
+	// only the UDPv4 transport
+	UDP,
+	// both, the shared-memory and the UDPv4 transport
+	SharedMemoryAndUDP
+};
+
+/** Resolves the QoS of the patterns from the profiles of an XML QoS library.
+ *
+ *  The profiles are looked up within the QoS library named LIBRARY_NAME (default: "SmartDDS"),
+ *  which is loaded by RTI's default QoS provider (e.g. from USER_QOS_PROFILES.xml or the files
+ *  listed in NDDS_QOS_PROFILES) or from the file set with setQosProvider(). The most specific
+ *  profile is used, i.e. "<server-component>.<service>" (per service, applies to both sides of
+ *  the connection), then "<component>" (per component) and then the pattern name (e.g. "PushPattern").
+ *  Only profiles that actually define a datareader_qos (or datawriter_qos, respectively) are considered,
+ *  so e.g. a "<component>" profile with only a domain_participant_qos does not affect the patterns.
+ *  If none of these profiles exists, the patterns use their hard-coded QoS (see e.g. PushPatternQoS).
+ *
+ *  A profile does not replace the hard-coded QoS of a pattern, but is overlaid onto it: each policy
+ *  that the profile sets to a value other than RTI's default replaces the related policy of the
+ *  pattern (see getReaderQos() and getWriterQos()). So a profile only needs to contain what differs.
+ *  Please note that a profile can therefore not reset a policy of the pattern to RTI's default value.
+ *  The resolved profile names are cached until the QoS provider is changed (see setQosProvider()).
+ */
+class DDSQosProfiles {
+public:
+	static std::string LIBRARY_NAME;
+
+	/** uses the QoS profiles from the given XML file instead of RTI's default QoS provider
+	 *  (please call this method before creating the components)
+	 */
+	static void setQosProvider(const std::string &uri);
+	static dds::core::QosProvider getQosProvider();
+
+	/** @return the fully qualified name of the most specific existing profile that defines a datareader_qos
+	 *          (or an empty string if there is none)
+	 */
+	static std::string findReaderProfile(const std::string &pattern_name, const std::string &component_name,
+			const std::string &server_name, const std::string &service_name);
+
+	/** @return the fully qualified name of the most specific existing profile that defines a datawriter_qos
+	 *          (or an empty string if there is none)
+	 */
+	static std::string findWriterProfile(const std::string &pattern_name, const std::string &component_name,
+			const std::string &server_name, const std::string &service_name);
+
+	/** @return the given built-in reader QoS of a pattern overlaid with the policies set by the profile
+	 *          (an empty profile name returns the built-in QoS unchanged)
+	 */
+	static dds::sub::qos::DataReaderQos getReaderQos(const std::string &profile_name, const dds::sub::qos::DataReaderQos &builtin_qos);
+
+	/** @return the given built-in writer QoS of a pattern overlaid with the policies set by the profile
+	 *          (an empty profile name returns the built-in QoS unchanged)
+	 */
+	static dds::pub::qos::DataWriterQos getWriterQos(const std::string &profile_name, const dds::pub::qos::DataWriterQos &builtin_qos);
+
+	/** @return the participant QoS of a component (from its profile if available) using the given transports
+	 */
+	static dds::domain::qos::DomainParticipantQos getParticipantQos(const std::string &component_name, const DDSTransport &transport);
+
+private:
+	static std::string findProfile(const std::string &entity_kind, const std::string &pattern_name, const std::string &component_name,
+			const std::string &server_name, const std::string &service_name);
+	static bool hasProfile(const std::string &profile_name);
+	static bool definesReaderQos(const std::string &profile_name);
+	static bool definesWriterQos(const std::string &profile_name);
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_DDSQOSPROFILES_H_ */
@@ -44,51 +44,50 @@
 #include "RTI-DDS-SmartSoft/DDSReaderConnector.h"
 
 namespace SmartDDS {
-	/**
-	 * @brief Handles the dds::core::status::RequestedIncompatibleQosStatus status
-	 *
-	 * @details \dref_details_DataReaderListener_on_requested_incompatible_qos
-	 */
-	void DDSReaderConnector::on_requested_incompatible_qos(
-			DynamicDataReader& reader,
-			const dds::core::status::RequestedIncompatibleQosStatus& status)
+	dds::sub::Subscriber DDSReaderConnectorBase::create_subscriber() const
 	{
-		incompatible_qos_guard.trigger_value(true);
+		// all readers of a component share the same subscriber
+		return component->DDS().getSubscriber();
 	}
 
-	/**
-	 * @brief Handles the dds::core::status::SubscriptionMatchedStatus status
-	 *
-	 * @details \dref_details_DataReaderListener_on_subscription_matched
-	 */
-	void DDSReaderConnector::on_subscription_matched(
-			DynamicDataReader& reader,
-			const dds::core::status::SubscriptionMatchedStatus& status)
-	{
-		if(status.total_count() > 0) {
-			connection_guard.trigger_value(true);
-		}
-	}
-
-	dds::sub::Subscriber DDSReaderConnector::create_subscriber() const
+	DDSReaderConnectorBase::DDSReaderConnectorBase(Component* component, const dds::topic::qos::TopicQos &topic_qos)
+	:	component(component)
+	,	topic_qos(topic_qos)
+	,	history_depth(0)
 	{
-		return dds::sub::Subscriber(component->DDS().getDomainParticipant());
+		setQosProfile("");
 	}
 
-	DDSReaderConnector::DDSReaderConnector(Component* component, const dds::topic::qos::TopicQos &topic_qos)
-	:	component(component)
+	void DDSReaderConnectorBase::setQosProfile(const std::string &profile)
 	{
 		reader_qos = dds::core::QosProvider::Default().datareader_qos();
 		// we use the topic QoS to specify the reader QoS
 		reader_qos = topic_qos;
+		// the XML profile (if any) is overlaid onto the pattern's QoS
+		reader_qos = DDSQosProfiles::getReaderQos(profile, reader_qos);
+		apply_history_depth();
 	}
 
-	Smart::StatusCode DDSReaderConnector::wait_for_connection(
-			DynamicDataReader & dds_reader,
-			const Smart::Duration & timeout,
-			DynamicDataReaderListener* the_listener,
-			const dds::core::status::StatusMask& mask
-			)
+	void DDSReaderConnectorBase::setHistoryDepth(const int32_t &depth)
+	{
+		history_depth = depth;
+		apply_history_depth();
+	}
+
+	void DDSReaderConnectorBase::apply_history_depth()
+	{
+		if(history_depth > 0) {
+			reader_qos << dds::core::policy::History::KeepLast(history_depth);
+		}
+	}
+
+	void DDSReaderConnectorBase::reset_guards()
+	{
+		connection_guard.trigger_value(false);
+		incompatible_qos_guard.trigger_value(false);
+	}
+
+	Smart::StatusCode DDSReaderConnectorBase::wait_for_guards(const Smart::Duration & timeout)
 	{
 		try {
 			dds::core::cond::WaitSet wait_set;
@@ -99,17 +98,13 @@ namespace SmartDDS {
 
 			if(active_conditions.size() == 0) {
 				// if no specified conditions are active, then the only thing that could have happened is a timeout
-				reset(dds_reader);
 				return Smart::StatusCode::SMART_SERVICEUNAVAILABLE;
 			} else {
 				// check the active conditions
 				for(auto condition: active_conditions) {
 					if(condition == connection_guard) {
-						// now we reset the listener pointer
-						dds_reader.listener(the_listener, mask);
 						return Smart::StatusCode::SMART_OK;
 					} else if(condition == incompatible_qos_guard) {
-						reset(dds_reader);
 						return Smart::StatusCode::SMART_INCOMPATIBLESERVICE;
 					}
 				}
@@ -117,15 +112,6 @@ namespace SmartDDS {
 		} catch(dds::core::Error &error) {
 			std::cerr << error.what() << std::endl;
 		}
-		// make sure the reader is in a consistent disconnected state at the end event in presence of errors
-		reset(dds_reader);
 		return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
 	}
-
-	void DDSReaderConnector::reset(DynamicDataReader &dds_reader) {
-		if(!dds_reader.is_nil()) {
-			dds_reader.listener(NULL, dds::core::status::StatusMask::none());
-			dds_reader = nullptr;
-		}
-	}
 } /* namespace SmartDDS */
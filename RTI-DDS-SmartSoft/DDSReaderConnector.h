@@ -48,26 +48,80 @@
 
 #include "RTI-DDS-SmartSoft/Component.h"
 #include "RTI-DDS-SmartSoft/DDSAliases.h"
+#include "RTI-DDS-SmartSoft/DDSQosProfiles.h"
 
 namespace SmartDDS {
 
-class DDSReaderConnector
-:	public DynamicDataReaderListener
+/** The sample-type independent part of the reader connector (subscriber creation and connection guards)
+ */
+class DDSReaderConnectorBase
 {
 private:
 	Component* component;
+	dds::topic::qos::TopicQos topic_qos;
+	// zero keeps the history depth as defined by the QoS (see setHistoryDepth)
+	int32_t history_depth;
+
+	void apply_history_depth();
+
+protected:
 	dds::sub::qos::DataReaderQos reader_qos;
 	dds::core::cond::GuardCondition connection_guard;
 	dds::core::cond::GuardCondition incompatible_qos_guard;
 
 	dds::sub::Subscriber create_subscriber() const;
 
+	/** blocks until either the connection or the incompatible-QoS guard is triggered
+	 *
+	 * @return SMART_OK if connected, SMART_SERVICEUNAVAILABLE on timeout, SMART_INCOMPATIBLESERVICE or SMART_ERROR_COMMUNICATION otherwise
+	 */
+	Smart::StatusCode wait_for_guards(const Smart::Duration & timeout);
+
+	void reset_guards();
+
+public:
+	DDSReaderConnectorBase(Component* component, const dds::topic::qos::TopicQos &topic_qos);
+	virtual ~DDSReaderConnectorBase() = default;
+
+	/** the readers created from here on use the given XML QoS profile (see DDSQosProfiles::findReaderProfile),
+	 *  which is overlaid onto the pattern's QoS (an empty profile name selects the pattern's QoS as is)
+	 */
+	void setQosProfile(const std::string &profile);
+
+	/** the readers created from here on keep the given number of not yet taken samples
+	 *  (zero uses the history depth of the pattern's QoS or of its XML QoS profile)
+	 */
+	void setHistoryDepth(const int32_t &depth);
+};
+
+template <class SampleType = DynamicDataSample>
+class DDSReaderConnector
+:	public DDSReaderConnectorBase
+,	public DDSReaderListener<SampleType>
+{
+private:
 	Smart::StatusCode wait_for_connection(
-			DynamicDataReader & dds_reader,
+			DDSReader<SampleType> & dds_reader,
 			const Smart::Duration & timeout,
-			DynamicDataReaderListener* the_listener,
+			DDSReaderListener<SampleType>* the_listener,
 			const dds::core::status::StatusMask& mask
-			);
+			)
+	{
+		auto status = wait_for_guards(timeout);
+		if(status == Smart::StatusCode::SMART_OK) {
+			try {
+				// now we reset the listener pointer
+				dds_reader.listener(the_listener, mask);
+				return Smart::StatusCode::SMART_OK;
+			} catch(dds::core::Error &error) {
+				std::cerr << error.what() << std::endl;
+				status = Smart::StatusCode::SMART_ERROR_COMMUNICATION;
+			}
+		}
+		// make sure the reader is in a consistent disconnected state at the end event in presence of errors
+		reset(dds_reader);
+		return status;
+	}
 
 	/**
 	 * @brief Handles the dds::core::status::RequestedIncompatibleQosStatus status
@@ -75,48 +129,62 @@ private:
 	 * @details \dref_details_DataReaderListener_on_requested_incompatible_qos
 	 */
 	virtual void on_requested_incompatible_qos(
-			DynamicDataReader& reader,
-			const dds::core::status::RequestedIncompatibleQosStatus& status) override;
+			DDSReader<SampleType>& reader,
+			const dds::core::status::RequestedIncompatibleQosStatus& status) override
+	{
+		incompatible_qos_guard.trigger_value(true);
+	}
 	/**
 	 * @brief Handles the dds::core::status::SubscriptionMatchedStatus status
 	 *
 	 * @details \dref_details_DataReaderListener_on_subscription_matched
 	 */
 	virtual void on_subscription_matched(
-			DynamicDataReader& reader,
-			const dds::core::status::SubscriptionMatchedStatus& status) override;
+			DDSReader<SampleType>& reader,
+			const dds::core::status::SubscriptionMatchedStatus& status) override
+	{
+		if(status.total_count() > 0) {
+			connection_guard.trigger_value(true);
+		}
+	}
 
 public:
-	DDSReaderConnector(Component* component, const dds::topic::qos::TopicQos &topic_qos);
+	DDSReaderConnector(Component* component, const dds::topic::qos::TopicQos &topic_qos)
+	:	DDSReaderConnectorBase(component, topic_qos)
+	{  }
 	virtual ~DDSReaderConnector() = default;
 
-	void reset(DynamicDataReader &dds_reader);
+	void reset(DDSReader<SampleType> &dds_reader) {
+		if(!dds_reader.is_nil()) {
+			dds_reader.listener(NULL, dds::core::status::StatusMask::none());
+			dds_reader = nullptr;
+		}
+	}
 
 	template <typename TopicType>
-	DynamicDataReader create_new_reader(
+	DDSReader<SampleType> create_new_reader(
 			const TopicType &dds_topic,
-			DynamicDataReaderListener* the_listener = NULL,
+			DDSReaderListener<SampleType>* the_listener = NULL,
 			const dds::core::status::StatusMask& mask = dds::core::status::StatusMask::all())
 	{
 		try {
-			return DynamicDataReader(create_subscriber(), dds_topic, reader_qos, the_listener, mask);
+			return DDSReader<SampleType>(create_subscriber(), dds_topic, reader_qos, the_listener, mask);
 		} catch(dds::core::Error &error) {
 			std::cerr << error.what() << std::endl;
 		}
-		return DynamicDataReader(nullptr);
+		return DDSReader<SampleType>(nullptr);
 	}
 
 	template <typename TopicType>
 	Smart::StatusCode reconnect(
-			DynamicDataReader & dds_reader,
+			DDSReader<SampleType> & dds_reader,
 			const TopicType & dds_topic,
 			const Smart::Duration & timeout = Smart::Duration::zero(),
-			DynamicDataReaderListener* the_listener = NULL,
+			DDSReaderListener<SampleType>* the_listener = NULL,
 			const dds::core::status::StatusMask& mask = dds::core::status::StatusMask::all())
 	{
 		//reset both guards
-		connection_guard.trigger_value(false);
-		incompatible_qos_guard.trigger_value(false);
+		reset_guards();
 		// create a new reader whose connection status is not yet acknowledged
 		dds_reader = create_new_reader(dds_topic, this);
 		if(dds_reader.is_nil()) {
@@ -0,0 +1,133 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_DDSSAMPLEPOOL_H_
+#define RTIDDSSMARTSOFT_DDSSAMPLEPOOL_H_
+
+#include <mutex>
+#include <memory>
+#include <vector>
+
+#include "RTI-DDS-SmartSoft/DDSTypeTraits.h"
+
+namespace SmartDDS {
+
+/** A pool of pre-built writer samples that are reused for each write.
+ *
+ *  After the warm-up phase (i.e. once the pool holds as many samples as
+ *  there are concurrent writes), acquiring and releasing a sample does
+ *  not allocate any memory. For DynamicData samples, this requires the
+ *  serialize_into() customization point (see DDSSerializeInto),
+ *  otherwise the sample is re-assigned from serialize() on each write.
+ */
+template <class DataType>
+class DDSSamplePool {
+public:
+	using TypeTraits = DDSTypeTraits<DataType>;
+	using SampleType = typename TypeTraits::SampleType;
+
+	struct SampleReleaser {
+		DDSSamplePool *pool;
+		void operator()(SampleType *sample) const {
+			pool->release(sample);
+		}
+	};
+	using SamplePtr = std::unique_ptr<SampleType, SampleReleaser>;
+
+private:
+	std::mutex pool_mutex;
+	std::vector<std::unique_ptr<SampleType>> free_samples;
+	const size_t max_pool_size;
+
+	void release(SampleType *sample)
+	{
+		std::unique_ptr<SampleType> released_sample(sample);
+		std::unique_lock<std::mutex> pool_lock(pool_mutex);
+		if(free_samples.size() < max_pool_size) {
+			// the capacity is reserved upfront, so this never allocates
+			free_samples.push_back(std::move(released_sample));
+		}
+	}
+
+public:
+	DDSSamplePool(const size_t &max_pool_size = 4)
+	:	max_pool_size(max_pool_size)
+	{
+		free_samples.reserve(max_pool_size);
+	}
+	virtual ~DDSSamplePool() = default;
+
+	// the released samples refer to the pool, so it must neither be copied nor moved
+	DDSSamplePool(const DDSSamplePool&) = delete;
+	DDSSamplePool& operator=(const DDSSamplePool&) = delete;
+
+	/** acquires a (pooled) sample and fills it with the given object
+	 *
+	 *  The sample is given back to the pool as soon as the returned pointer is destroyed.
+	 */
+	SamplePtr acquire(const DataType &object)
+	{
+		std::unique_ptr<SampleType> sample;
+		{
+			std::unique_lock<std::mutex> pool_lock(pool_mutex);
+			if(!free_samples.empty()) {
+				sample = std::move(free_samples.back());
+				free_samples.pop_back();
+			}
+		}
+		if(!sample) {
+			sample.reset(new SampleType(TypeTraits::createSample()));
+		}
+		TypeTraits::toSample(object, *sample);
+		return SamplePtr(sample.release(), SampleReleaser{this});
+	}
+
+	size_t size()
+	{
+		std::unique_lock<std::mutex> pool_lock(pool_mutex);
+		return free_samples.size();
+	}
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_DDSSAMPLEPOOL_H_ */
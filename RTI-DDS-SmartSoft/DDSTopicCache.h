@@ -0,0 +1,129 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_DDSTOPICCACHE_H_
+#define RTIDDSSMARTSOFT_DDSTOPICCACHE_H_
+
+#include <array>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <typeindex>
+#include <unordered_map>
+
+namespace SmartDDS {
+
+/** A reference-counted cache of the Topic and ContentFilteredTopic handles of a DDSInfrastructure.
+ *
+ *  The handles are hashed by their name and handle type and are distributed over several
+ *  shards, each of which has its own mutex, so concurrent (re-)connections of different
+ *  patterns do not serialize on a single lock and do not need the participant-wide lookup.
+ *  A cached handle is dropped as soon as its last user releases it.
+ */
+class DDSTopicCache {
+private:
+	struct Key {
+		std::type_index type;
+		std::string name;
+		bool operator==(const Key &other) const {
+			return type == other.type && name == other.name;
+		}
+	};
+	struct KeyHash {
+		size_t operator()(const Key &key) const;
+	};
+	struct Entry {
+		// the handle is type-erased as topics of different sample types share the same cache
+		std::shared_ptr<void> handle;
+		size_t users;
+	};
+	struct Shard {
+		std::mutex shard_mutex;
+		std::unordered_map<Key, Entry, KeyHash> entries;
+	};
+
+	static const size_t SHARD_COUNT = 16;
+	std::array<Shard, SHARD_COUNT> shards;
+
+	Shard& getShard(const Key &key);
+
+public:
+	/** returns the cached handle (and increments its user count), or creates a new handle using the given factory
+	 */
+	template <class HandleType, class Factory>
+	HandleType acquire(const std::string &name, Factory create_handle)
+	{
+		Key key { typeid(HandleType), name };
+		Shard &shard = getShard(key);
+		std::unique_lock<std::mutex> shard_lock(shard.shard_mutex);
+		auto entry = shard.entries.find(key);
+		if(entry != shard.entries.end()) {
+			entry->second.users++;
+			return *std::static_pointer_cast<HandleType>(entry->second.handle);
+		}
+		auto handle = std::make_shared<HandleType>(create_handle());
+		shard.entries.emplace(key, Entry{handle, 1});
+		return *handle;
+	}
+
+	/** decrements the user count of a cached handle, the last user drops the handle from the cache
+	 */
+	template <class HandleType>
+	void release(const std::string &name)
+	{
+		Key key { typeid(HandleType), name };
+		Shard &shard = getShard(key);
+		std::unique_lock<std::mutex> shard_lock(shard.shard_mutex);
+		auto entry = shard.entries.find(key);
+		if(entry != shard.entries.end() && --entry->second.users == 0) {
+			shard.entries.erase(entry);
+		}
+	}
+
+	// drops all cached handles (independent of their user count)
+	void clear();
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_DDSTOPICCACHE_H_ */
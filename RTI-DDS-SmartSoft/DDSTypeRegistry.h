@@ -0,0 +1,154 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_DDSTYPEREGISTRY_H_
+#define RTIDDSSMARTSOFT_DDSTYPEREGISTRY_H_
+
+#include <type_traits>
+
+#include <dds/dds.hpp>
+
+#include "RTI-DDS-SmartSoft/DDSAliases.h"
+
+// forward declaration of the externally implemented dynamic type (see e.g. examples/CommPose6dDDS.h)
+template <typename T>
+dds::core::xtypes::StructType dds_type();
+
+namespace SmartDDS {
+
+/** Process-wide cache of the dynamic DDS types.
+ *
+ *  The externally implemented dds_type<DataType>() builds a new StructType (including all
+ *  nested member types) on each call. The registry calls it exactly once per DataType and
+ *  returns a reference to the cached type from there on. Use it in serialize() and in
+ *  nested dds_type() implementations instead of calling dds_type<DataType>() directly:
+ *
+ *  @code
+ *  DynamicData data(SmartDDS::DDSTypeRegistry::get<CommExampleObjects::CommPose6d>());
+ *  @endcode
+ */
+class DDSTypeRegistry {
+public:
+	template <typename DataType>
+	static const DynamicStructType& get()
+	{
+		// the initialization of function-local statics is thread-safe (since C++11)
+		static const DynamicStructType cached_type = dds_type<DataType>();
+		return cached_type;
+	}
+};
+
+/** Opt-in customization point for communication objects that provide the global function
+ *  serialize_into(DynamicData&, const DataType&), which fills a pre-built (and reused) DynamicData
+ *  sample instead of creating a new one (see DDSSamplePool).
+ *
+ *  The trait is specialized right after the declaration of serialize_into (i.e. within the same header),
+ *  so all translation units that use the communication object see the same definition:
+ *
+ *  @code
+ *  void serialize_into(dds::core::xtypes::DynamicData &data, const CommExampleObjects::CommPose6d &object);
+ *
+ *  namespace SmartDDS {
+ *  template<> struct DDSSerializeInto<CommExampleObjects::CommPose6d>
+ *  :	DDSSerializeIntoFunction<CommExampleObjects::CommPose6d, &::serialize_into> {};
+ *  }
+ *  @endcode
+ */
+template <class DataType>
+struct DDSSerializeInto : std::false_type {};
+
+// binds the given serialize_into overload to a DDSSerializeInto specialization (see above)
+template <class DataType, void (*SerializeInto)(DynamicDataSample&, const DataType&)>
+struct DDSSerializeIntoFunction : std::true_type {
+	static void apply(DynamicDataSample &sample, const DataType &object) {
+		SerializeInto(sample, object);
+	}
+};
+
+/** Customization point selecting an IDL-generated (rtiddsgen) type for a communication object.
+ *
+ *  By default, all communication objects are transmitted as DynamicData, which requires the
+ *  global functions dds_type<DataType>(), serialize(const DataType&) and convert(const DynamicData&, DataType&)
+ *  (and optionally serialize_into(DynamicData&, const DataType&), see DDSSerializeInto).
+ *  To use the statically typed code path instead (which avoids the member-by-member DynamicData
+ *  accessors), specialize this trait for the communication object and provide the two global
+ *  mapping functions (see e.g. examples/CommPose6dDDS.h and examples/CommPose6d.idl):
+ *
+ *  @code
+ *  #include "CommPose6d.hpp" // generated by rtiddsgen
+ *
+ *  void serialize(const CommExampleObjects::CommPose6d &object, CommExampleObjectsIdl::CommPose6d &sample);
+ *  void convert(const CommExampleObjectsIdl::CommPose6d &sample, CommExampleObjects::CommPose6d &object);
+ *
+ *  namespace SmartDDS {
+ *  template<> struct DDSIdlType<CommExampleObjects::CommPose6d> {
+ *  	using type = CommExampleObjectsIdl::CommPose6d;
+ *  };
+ *  }
+ *  @endcode
+ *
+ *  Like DDSSerializeInto, this trait is defined here (and not within DDSTypeTraits.h), so the header of
+ *  the communication object can specialize it before the pattern templates are defined.
+ */
+template <class DataType>
+struct DDSIdlType {
+	using type = void;
+};
+
+/** Opt-in zero-copy transfer for large communication objects (e.g. camera images or laser scans).
+ *
+ *  Only applies to communication objects with an IDL-generated type (see DDSIdlType) whose IDL type
+ *  is annotated with @transfer_mode(SHMEM_REF). The PushServerPattern then writes samples loaned from
+ *  the shared-memory segment, so co-located readers receive a reference instead of a serialized copy:
+ *
+ *  @code
+ *  namespace SmartDDS {
+ *  template<> struct DDSZeroCopyType<CommExampleObjects::CommImage> : std::true_type {};
+ *  }
+ *  @endcode
+ */
+template <class DataType>
+struct DDSZeroCopyType : std::false_type {};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_DDSTYPEREGISTRY_H_ */
@@ -0,0 +1,124 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_DDSTYPETRAITS_H_
+#define RTIDDSSMARTSOFT_DDSTYPETRAITS_H_
+
+#include <string>
+#include <utility>
+#include <type_traits>
+
+#include <dds/dds.hpp>
+
+#include "RTI-DDS-SmartSoft/DDSAliases.h"
+#include "RTI-DDS-SmartSoft/DDSInfrastructure.h"
+#include "RTI-DDS-SmartSoft/DDSTypeRegistry.h"
+
+namespace SmartDDS {
+
+/** The default DDSTypeTraits use DynamicData samples.
+ */
+template <class DataType, class Enable = void>
+struct DDSTypeTraits {
+	using SampleType = DynamicDataSample;
+	static constexpr bool is_dynamic = true;
+	// DynamicData can not be transferred via shared-memory references
+	static constexpr bool zero_copy = false;
+
+	static DDSTopic<SampleType> findOrCreateTopic(DDSInfrastructure &dds, const std::string &topic_name) {
+		// the dynamic type is determined from an externally implemented template method dds_type() (built only once)
+		return dds.findOrCreateTopic(topic_name, DDSTypeRegistry::get<DataType>());
+	}
+	static SampleType createSample() {
+		return SampleType(DDSTypeRegistry::get<DataType>());
+	}
+	static SampleType toSample(const DataType &object) {
+		return serialize(object);
+	}
+	// fills an existing sample (see DDSSamplePool), this only avoids allocations if DDSSerializeInto is specialized
+	static void toSample(const DataType &object, SampleType &sample) {
+		toSample(object, sample, std::integral_constant<bool, DDSSerializeInto<DataType>::value>());
+	}
+	static void fromSample(const SampleType &sample, DataType &object) {
+		convert(sample, object);
+	}
+private:
+	static void toSample(const DataType &object, SampleType &sample, std::true_type) {
+		sample.clear_all_values();
+		DDSSerializeInto<DataType>::apply(sample, object);
+	}
+	static void toSample(const DataType &object, SampleType &sample, std::false_type) {
+		sample = serialize(object);
+	}
+};
+
+/** The DDSTypeTraits specialization for communication objects with an IDL-generated type (see DDSIdlType).
+ */
+template <class DataType>
+struct DDSTypeTraits<DataType, typename std::enable_if<dds::topic::is_topic_type<typename DDSIdlType<DataType>::type>::value>::type> {
+	using SampleType = typename DDSIdlType<DataType>::type;
+	static constexpr bool is_dynamic = false;
+	static constexpr bool zero_copy = DDSZeroCopyType<DataType>::value;
+
+	static DDSTopic<SampleType> findOrCreateTopic(DDSInfrastructure &dds, const std::string &topic_name) {
+		// the type is registered implicitly by the generated type-support code
+		return dds.template findOrCreateTopic<SampleType>(topic_name);
+	}
+	static SampleType createSample() {
+		return SampleType();
+	}
+	static SampleType toSample(const DataType &object) {
+		SampleType sample;
+		serialize(object, sample);
+		return sample;
+	}
+	static void toSample(const DataType &object, SampleType &sample) {
+		serialize(object, sample);
+	}
+	static void fromSample(const SampleType &sample, DataType &object) {
+		convert(sample, object);
+	}
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_DDSTYPETRAITS_H_ */
@@ -0,0 +1,127 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#include "RTI-DDS-SmartSoft/DDSWaitSetPool.h"
+
+#include <iostream>
+
+namespace SmartDDS {
+
+DDSWaitSetPool::ScopedWaitSet::ScopedWaitSet(DDSWaitSetPool *pool, std::unique_ptr<Entry> &&entry)
+:	pool(pool)
+,	entry(std::move(entry))
+{  }
+
+DDSWaitSetPool::ScopedWaitSet::~ScopedWaitSet()
+{
+	if(!entry)
+		return;
+	try {
+		for(const auto &condition: entry->call_conditions) {
+			entry->wait_set.detach_condition(condition);
+		}
+		if(entry->guard_attached) {
+			entry->wait_set.detach_condition(entry->guard);
+			entry->guard_attached = false;
+		}
+	} catch(dds::core::Error &error) {
+		// a WaitSet in an unknown state is not returned into the pool
+		std::cerr << error.what() << std::endl;
+		return;
+	}
+	entry->call_conditions.clear();
+	pool->release(std::move(entry));
+}
+
+void DDSWaitSetPool::ScopedWaitSet::attach(const dds::core::cond::Condition &condition)
+{
+	entry->wait_set.attach_condition(condition);
+	entry->call_conditions.push_back(condition);
+}
+
+dds::core::cond::GuardCondition& DDSWaitSetPool::ScopedWaitSet::attachGuard()
+{
+	entry->guard.trigger_value(false);
+	if(!entry->guard_attached) {
+		entry->wait_set.attach_condition(entry->guard);
+		entry->guard_attached = true;
+	}
+	return entry->guard;
+}
+
+const dds::core::cond::WaitSet::ConditionSeq& DDSWaitSetPool::ScopedWaitSet::wait(const Smart::Duration &timeout)
+{
+	// the sequence of active conditions is reused as well
+	entry->active_conditions.clear();
+	return entry->wait_set.wait(entry->active_conditions, timeout);
+}
+
+DDSWaitSetPool::DDSWaitSetPool(const std::vector<dds::core::cond::Condition> &common_conditions)
+:	common_conditions(common_conditions)
+{  }
+
+DDSWaitSetPool::ScopedWaitSet DDSWaitSetPool::acquire()
+{
+	{
+		std::unique_lock<std::mutex> pool_lock(pool_mutex);
+		if(!free_entries.empty()) {
+			auto entry = std::move(free_entries.back());
+			free_entries.pop_back();
+			return ScopedWaitSet(this, std::move(entry));
+		}
+	}
+	// a new WaitSet is only created if all pooled ones are currently in use
+	std::unique_ptr<Entry> entry(new Entry());
+	entry->guard_attached = false;
+	for(const auto &condition: common_conditions) {
+		entry->wait_set.attach_condition(condition);
+	}
+	return ScopedWaitSet(this, std::move(entry));
+}
+
+void DDSWaitSetPool::release(std::unique_ptr<Entry> &&entry)
+{
+	std::unique_lock<std::mutex> pool_lock(pool_mutex);
+	free_entries.push_back(std::move(entry));
+}
+
+} /* namespace SmartDDS */
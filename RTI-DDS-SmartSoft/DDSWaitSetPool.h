@@ -0,0 +1,112 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_DDSWAITSETPOOL_H_
+#define RTIDDSSMARTSOFT_DDSWAITSETPOOL_H_
+
+#include <dds/dds.hpp>
+
+#include <smartChronoAliases.h>
+
+#include <mutex>
+#include <memory>
+#include <vector>
+
+namespace SmartDDS {
+
+/** A pool of WaitSets that are reused by the blocking calls of a client pattern.
+ *
+ *  A WaitSet can only be waited on by a single thread at a time, so the blocking calls used
+ *  to create (and attach) a new WaitSet on each call. Instead, each pooled WaitSet keeps the
+ *  conditions that are common to all calls (e.g. the disconnected and non-blocking guards)
+ *  attached, and a call only attaches its call-specific conditions for the time of waiting.
+ *  The pool grows up to the number of concurrently waiting threads.
+ */
+class DDSWaitSetPool {
+private:
+	struct Entry {
+		dds::core::cond::WaitSet wait_set;
+		// a reusable guard for calls that need an individual guard (see ScopedWaitSet::attachGuard)
+		dds::core::cond::GuardCondition guard;
+		bool guard_attached;
+		dds::core::cond::WaitSet::ConditionSeq active_conditions;
+		std::vector<dds::core::cond::Condition> call_conditions;
+	};
+
+	const std::vector<dds::core::cond::Condition> common_conditions;
+
+	std::mutex pool_mutex;
+	std::vector<std::unique_ptr<Entry>> free_entries;
+
+	void release(std::unique_ptr<Entry> &&entry);
+
+public:
+	/** A WaitSet borrowed from the pool, which is returned (with the call-specific conditions detached) on destruction.
+	 */
+	class ScopedWaitSet {
+	private:
+		DDSWaitSetPool *pool;
+		std::unique_ptr<Entry> entry;
+	public:
+		ScopedWaitSet(DDSWaitSetPool *pool, std::unique_ptr<Entry> &&entry);
+		ScopedWaitSet(ScopedWaitSet &&other) = default;
+		~ScopedWaitSet();
+
+		/// attaches a call-specific condition (until this WaitSet is returned)
+		void attach(const dds::core::cond::Condition &condition);
+
+		/// attaches the reusable guard of this WaitSet (its trigger value is reset to false)
+		dds::core::cond::GuardCondition& attachGuard();
+
+		/// blocks until at least one condition is triggered (the result is empty on timeout)
+		const dds::core::cond::WaitSet::ConditionSeq& wait(const Smart::Duration &timeout);
+	};
+
+	DDSWaitSetPool(const std::vector<dds::core::cond::Condition> &common_conditions);
+
+	/// borrows a WaitSet with all the common conditions attached
+	ScopedWaitSet acquire();
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_DDSWAITSETPOOL_H_ */
@@ -44,86 +44,158 @@
 
 namespace SmartDDS {
 
-    void DDSWriterConnector::on_publication_matched(DynamicDataWriter &writer, const PublicationMatchedStatus &status)
-    {
-    	if(status.current_count() > 0) {
-    		connection_guard.trigger_value(true);
-    	}
-    }
-
-    DDSWriterConnector::DDSWriterConnector(Component* component, const dds::topic::qos::TopicQos &topic_qos)
+	std::string DDSAsyncPublishSettings::getFlowControllerName() const
+	{
+		if(!flow_controller_name.empty()) {
+			return flow_controller_name;
+		}
+		auto period_us = std::chrono::duration_cast<std::chrono::microseconds>(period).count();
+		return "SmartDDS::FlowController::" + std::to_string(bytes_per_token) + "B:"
+				+ std::to_string(tokens_per_period) + "/" + std::to_string(period_us) + "us:"
+				+ std::to_string(max_tokens);
+	}
+
+	DDSWriterConnectorBase::DDSWriterConnectorBase(Component* component, const dds::topic::qos::TopicQos &topic_qos,
+			const DDSWriterMemorySettings &memory_settings)
 	:	component(component)
 	,	topic_qos(topic_qos)
+	,	memory_settings(memory_settings)
 	{  }
 
-	void DDSWriterConnector::reset(DynamicDataWriter &dds_writer) const {
-		if(!dds_writer.is_nil()) {
-			dds_writer.listener(NULL, dds::core::status::StatusMask::none());
-			dds_writer = nullptr;
+	int32_t DDSWriterConnectorBase::get_pool_buffer_max_size() const
+	{
+		size_t observed_size = max_sample_size;
+		if(memory_settings.adaptive && observed_size > 0) {
+			// round the largest measured sample size up to the next power of two
+			int32_t pool_buffer_max_size = 1024;
+			while(static_cast<size_t>(pool_buffer_max_size) < observed_size && pool_buffer_max_size < (1 << 30)) {
+				pool_buffer_max_size <<= 1;
+			}
+			return pool_buffer_max_size;
 		}
+		return memory_settings.pool_buffer_max_size;
 	}
 
-	DynamicDataWriter DDSWriterConnector::create_new_writer(
-			const DynamicDataTopic &dds_topic,
-			DynamicDataWriterListener* the_listener,
-			const dds::core::status::StatusMask& mask) const
+	bool DDSWriterConnectorBase::is_measurement_due()
 	{
-		try {
-			auto domainParticipant = component->DDS().getDomainParticipant();
+		if(memory_settings.sampling_period == 0) {
+			return false;
+		}
+		return written_samples.fetch_add(1, std::memory_order_relaxed) % memory_settings.sampling_period == 0;
+	}
 
-			auto writer_qos = dds::core::QosProvider::Default().datawriter_qos();
-			writer_qos = topic_qos;
+	void DDSWriterConnectorBase::record_sample_size(const size_t &sample_size)
+	{
+		measured_samples++;
+		auto pool_buffer_max_size = current_pool_buffer_max_size.load();
+		if(pool_buffer_max_size >= 0 && sample_size > static_cast<size_t>(pool_buffer_max_size)) {
+			estimated_pool_misses++;
+		}
+		auto observed_size = max_sample_size.load();
+		while(sample_size > observed_size && !max_sample_size.compare_exchange_weak(observed_size, sample_size));
+	}
 
-			// If you are using RTI Connext DDS version 6.0.0, please comment in the following two lines of code
-			// to workaround a known bug in version 6.0.0, see:
-			// https://community.rti.com/forum-topic/segmentation-fault-when-using-contentfilteredtopic-dynamicdata-0
-			// Basically, this will deactivate the internal server-side filtering (as a workaround for the bug).
-			// This bug has been fixed since version 6.0.1, so if you are using this version or later,
-			// you don't need to deactivate server-side filtering anymore (which improves overall performance).
-//			rti::core::policy::DataWriterResourceLimits resource_limits;
-//			writer_qos << resource_limits.max_remote_reader_filters(0);
+	DDSWriterMemoryStatistics DDSWriterConnectorBase::getMemoryStatistics() const
+	{
+		DDSWriterMemoryStatistics statistics;
+		statistics.measured_samples = measured_samples;
+		statistics.estimated_pool_misses = estimated_pool_misses;
+		statistics.estimated_pool_hits = statistics.measured_samples - statistics.estimated_pool_misses;
+		statistics.max_sample_size = max_sample_size;
+		statistics.pool_buffer_max_size = current_pool_buffer_max_size;
+		return statistics;
+	}
 
-			rti::core::policy::Property qos_property;
-			writer_qos << qos_property.set({"dds.data_writer.history.memory_manager.fast_pool.pool_buffer_max_size", "32768"});
+	void DDSWriterConnectorBase::setBatching(const DDSBatchSettings &settings)
+	{
+		batch_settings = settings;
+	}
 
-			return DynamicDataWriter(dds::pub::Publisher(domainParticipant), dds_topic, writer_qos, the_listener, mask);
-		} catch(dds::core::Error &error) {
-			std::cerr << error.what() << std::endl;
-		}
-		return DynamicDataWriter(nullptr);
+	void DDSWriterConnectorBase::setQosProfile(const std::string &profile)
+	{
+		qos_profile = profile;
 	}
 
-	Smart::StatusCode DDSWriterConnector::reconnect(
-			DynamicDataWriter & dds_writer,
-			const DynamicDataTopic & dds_topic,
-			const Smart::Duration & timeout,
-			DynamicDataWriterListener* the_listener,
-			const dds::core::status::StatusMask& mask)
+	void DDSWriterConnectorBase::setAsynchronousPublishing(const DDSAsyncPublishSettings &settings)
 	{
-		try {
-			// reset the connection guard
-			connection_guard.trigger_value(false);
+		async_publish_settings = settings;
+	}
+
+	dds::pub::Publisher DDSWriterConnectorBase::create_publisher() const
+	{
+		// all writers of a component share the same publisher
+		return component->DDS().getPublisher();
+	}
+
+	dds::pub::qos::DataWriterQos DDSWriterConnectorBase::create_writer_qos() const
+	{
+		auto writer_qos = dds::core::QosProvider::Default().datawriter_qos();
+		// we use the topic QoS as a reference for the majority of writer's QoS policies
+		writer_qos = topic_qos;
+		// the XML profile (if any) is overlaid onto the pattern's QoS
+		writer_qos = DDSQosProfiles::getWriterQos(qos_profile, writer_qos);
 
-			// first we reset the writer with the new attributes including "this" as the listener pointer (see last parameter)
-			dds_writer = create_new_writer(dds_topic, this);
-			if(dds_writer.is_nil()) {
-				return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
+		// If you are using RTI Connext DDS version 6.0.0, please comment in the following two lines of code
+		// to workaround a known bug in version 6.0.0, see:
+		// https://community.rti.com/forum-topic/segmentation-fault-when-using-contentfilteredtopic-dynamicdata-0
+		// Basically, this will deactivate the internal server-side filtering (as a workaround for the bug).
+		// This bug has been fixed since version 6.0.1, so if you are using this version or later,
+		// you don't need to deactivate server-side filtering anymore (which improves overall performance).
+//		rti::core::policy::DataWriterResourceLimits resource_limits;
+//		writer_qos << resource_limits.max_remote_reader_filters(0);
+
+		// samples up to this size are served from the pre-allocated pool (see the pattern QoS classes)
+		auto pool_buffer_max_size = get_pool_buffer_max_size();
+		current_pool_buffer_max_size = pool_buffer_max_size;
+		rti::core::policy::Property qos_property;
+		writer_qos << qos_property.set({"dds.data_writer.history.memory_manager.fast_pool.pool_buffer_max_size", std::to_string(pool_buffer_max_size)});
+
+		if(batch_settings.enabled) {
+			// several samples are combined into one RTPS message, which reduces the per-sample overhead at high rates
+			rti::core::policy::Batch batch;
+			batch.enable(true);
+			batch.max_data_bytes(batch_settings.max_data_bytes);
+			// a negative number of samples corresponds to LENGTH_UNLIMITED
+			batch.max_samples(batch_settings.max_samples);
+			batch.max_flush_delay(dds::core::Duration(batch_settings.max_flush_delay));
+			writer_qos << batch;
+		}
+
+		if(async_publish_settings.enabled) {
+			// the samples are sent by the publisher's asynchronous thread using the (shared) token-bucket flow controller
+			rti::pub::FlowControllerTokenBucketProperty token_bucket(
+					async_publish_settings.max_tokens,
+					async_publish_settings.tokens_per_period,
+					0, // no tokens are leaked
+					dds::core::Duration(async_publish_settings.period),
+					async_publish_settings.bytes_per_token);
+			rti::pub::FlowControllerProperty flow_controller_property(
+					rti::pub::FlowControllerSchedulingPolicy::ROUND_ROBIN, token_bucket);
+			auto flow_controller_name = async_publish_settings.getFlowControllerName();
+			if(!component->DDS().findOrCreateFlowController(flow_controller_name, flow_controller_property)) {
+				// the writers of a shared flow controller would otherwise silently get the bandwidth of the first writer
+				throw dds::core::InconsistentPolicyError("the flow controller " + flow_controller_name + " already exists with different settings");
 			}
+			writer_qos << rti::core::policy::PublishMode::Asynchronous(flow_controller_name);
+		}
 
+		return writer_qos;
+	}
+
+	Smart::StatusCode DDSWriterConnectorBase::wait_for_guard(const Smart::Duration & timeout)
+	{
+		try {
 			dds::core::cond::WaitSet wait_set;
 			wait_set += connection_guard;
 			auto active_conditions = wait_set.wait(timeout);
 
 			if(active_conditions.size() == 0) {
 				// if no specified conditions are active, then the only thing that could have happened is a timeout
-				reset(dds_writer);
 				return Smart::StatusCode::SMART_SERVICEUNAVAILABLE;
 			} else {
 				// check the active conditions
 				for(auto condition: active_conditions) {
 					if(condition == connection_guard) {
-						// now we reset the listener pointer
-						dds_writer.listener(the_listener, mask);
 						return Smart::StatusCode::SMART_OK;
 					}
 				}
@@ -131,8 +203,6 @@ namespace SmartDDS {
 		} catch(dds::core::Error &error) {
 			std::cerr << error.what() << std::endl;
 		}
-		// make sure the reader is in a consistent disconnected state at the end event in presence of errors
-		reset(dds_writer);
 		return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
 	}
 
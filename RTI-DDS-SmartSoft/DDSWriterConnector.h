@@ -48,36 +48,205 @@
 
 #include "RTI-DDS-SmartSoft/Component.h"
 #include "RTI-DDS-SmartSoft/DDSAliases.h"
+#include "RTI-DDS-SmartSoft/DDSWriterMemorySettings.h"
+#include "RTI-DDS-SmartSoft/DDSQosProfiles.h"
+
+#include <mutex>
+#include <atomic>
+#include <vector>
 
 namespace SmartDDS {
 
-class DDSWriterConnector
-:	public DynamicDataWriterListener
+/** Opt-in writer-side batching of (small) samples using the RTI Batch QoS policy.
+ *
+ *  A batch is sent as soon as one of the limits is reached, the flush delay has expired
+ *  or the batch is explicitly flushed (see e.g. PushServerPattern::flush()).
+ *
+ *  Batching disables the writer-side content filtering, as the writer filters whole batches
+ *  instead of single samples. The CorrelationIdFilter of the prescaled and rate-limited push
+ *  subscriptions (see PushClientPattern::subscribe() and subscribeMaxRate()) is then evaluated
+ *  by each reader, i.e. every subscriber receives all samples (and the related network traffic)
+ *  and drops the excess samples after reception. Therefore, batching pays off if most subscribers
+ *  take (nearly) every sample, but not for a few high-rate samples shared with many thinned-out
+ *  subscribers (e.g. slow remote monitors).
+ */
+struct DDSBatchSettings {
+	bool enabled = false;
+	// the maximal accumulated size of the samples within a batch
+	int32_t max_data_bytes = 1024;
+	// the maximal number of samples within a batch (-1 means unlimited)
+	int32_t max_samples = -1;
+	// the maximal time a sample is delayed within a batch before the batch is sent
+	Smart::Duration max_flush_delay = std::chrono::milliseconds(1);
+};
+
+/** Opt-in asynchronous publishing (i.e. the write returns as soon as the sample is queued).
+ *
+ *  The queued samples are sent by a middleware thread whose bandwidth is shaped by a token-bucket
+ *  flow controller, so bulk data (e.g. maps or point clouds) does not starve other topics that
+ *  share the same network. Flow controllers with the same name are shared within a component
+ *  (i.e. their writers share the bandwidth). Without an explicit name, the name is derived from
+ *  the token-bucket settings, so only writers with identical settings share a flow controller.
+ *  A writer whose explicitly named flow controller already exists with different settings is
+ *  not created (the error is printed to std::cerr).
+ */
+struct DDSAsyncPublishSettings {
+	bool enabled = false;
+	// an empty name selects the flow controller of the given token-bucket settings (see getFlowControllerName())
+	std::string flow_controller_name;
+	// each period, tokens_per_period tokens (of bytes_per_token bytes each) are added to the
+	// bucket (up to max_tokens), which results in the maximal bandwidth (default ~100 MB/s)
+	int32_t bytes_per_token = 1024;
+	int32_t tokens_per_period = 1000;
+	int32_t max_tokens = 1000;
+	Smart::Duration period = std::chrono::milliseconds(10);
+
+	// the explicit flow_controller_name or otherwise a name that is derived from the token-bucket settings
+	std::string getFlowControllerName() const;
+};
+
+/** The sample-type independent part of the writer connector (publisher and QoS setup and the connection guard)
+ */
+class DDSWriterConnectorBase
 {
 private:
 	Component* component;
 	dds::topic::qos::TopicQos topic_qos;
+	std::string qos_profile;
+	DDSBatchSettings batch_settings;
+	DDSAsyncPublishSettings async_publish_settings;
+
+	DDSWriterMemorySettings memory_settings;
+	// the memory statistics are updated from the writing threads
+	std::atomic<uint64_t> written_samples { 0 };
+	std::atomic<uint64_t> measured_samples { 0 };
+	std::atomic<uint64_t> estimated_pool_misses { 0 };
+	std::atomic<size_t> max_sample_size { 0 };
+	mutable std::atomic<int32_t> current_pool_buffer_max_size { 0 };
+
+	int32_t get_pool_buffer_max_size() const;
+
+protected:
 	dds::core::cond::GuardCondition connection_guard;
 
-    virtual void on_publication_matched(DynamicDataWriter &writer, const PublicationMatchedStatus &status) override;
+	dds::pub::Publisher create_publisher() const;
+	dds::pub::qos::DataWriterQos create_writer_qos() const;
+
+	// returns true for every n-th written sample (according to the sampling period)
+	bool is_measurement_due();
+	void record_sample_size(const size_t &sample_size);
+
+	/** blocks until the connection guard is triggered
+	 *
+	 * @return SMART_OK if connected, SMART_SERVICEUNAVAILABLE on timeout or SMART_ERROR_COMMUNICATION otherwise
+	 */
+	Smart::StatusCode wait_for_guard(const Smart::Duration & timeout);
+
+public:
+	DDSWriterConnectorBase(Component* component, const dds::topic::qos::TopicQos &topic_qos,
+			const DDSWriterMemorySettings &memory_settings = DDSWriterMemorySettings());
+	virtual ~DDSWriterConnectorBase() = default;
+
+	DDSWriterMemoryStatistics getMemoryStatistics() const;
+
+	/** the writers created from here on use the given XML QoS profile (see DDSQosProfiles::findWriterProfile),
+	 *  which is overlaid onto the pattern's QoS (an empty profile name selects the pattern's QoS as is)
+	 */
+	void setQosProfile(const std::string &profile);
+
+	// the batch settings are applied to all writers created from here on
+	void setBatching(const DDSBatchSettings &settings);
+	// the asynchronous publishing settings are applied to all writers created from here on
+	void setAsynchronousPublishing(const DDSAsyncPublishSettings &settings);
+};
+
+template <class SampleType = DynamicDataSample>
+class DDSWriterConnector
+:	public DDSWriterConnectorBase
+,	public DDSWriterListener<SampleType>
+{
+private:
+	// the serialization buffer of the sample size measurements (see observe())
+	std::mutex measurement_mutex;
+	std::vector<char> measurement_buffer;
+
+	virtual void on_publication_matched(DDSWriter<SampleType> &writer, const PublicationMatchedStatus &status) override
+	{
+		if(status.current_count() > 0) {
+			connection_guard.trigger_value(true);
+		}
+	}
 
 public:
-    DDSWriterConnector(Component* component, const dds::topic::qos::TopicQos &topic_qos);
+	DDSWriterConnector(Component* component, const dds::topic::qos::TopicQos &topic_qos,
+			const DDSWriterMemorySettings &memory_settings = DDSWriterMemorySettings())
+	:	DDSWriterConnectorBase(component, topic_qos, memory_settings)
+	{  }
+
+	/** measures the serialized size of every n-th written sample (if a sampling period is configured)
+	 */
+	void observe(const SampleType &sample)
+	{
+		if(is_measurement_due()) {
+			// the buffer keeps its capacity, so the measurements do not allocate in steady state
+			std::unique_lock<std::mutex> measurement_lock(measurement_mutex);
+			dds::topic::topic_type_support<SampleType>::to_cdr_buffer(measurement_buffer, sample);
+			record_sample_size(measurement_buffer.size());
+		}
+	}
 	virtual ~DDSWriterConnector() = default;
 
-	void reset(DynamicDataWriter &dds_writer) const;
+	void reset(DDSWriter<SampleType> &dds_writer) const {
+		if(!dds_writer.is_nil()) {
+			dds_writer.listener(NULL, dds::core::status::StatusMask::none());
+			dds_writer = nullptr;
+		}
+	}
 
-	DynamicDataWriter create_new_writer(
-			const DynamicDataTopic &dds_topic,
-			DynamicDataWriterListener* the_listener = NULL,
-			const dds::core::status::StatusMask& mask = dds::core::status::StatusMask::all()) const;
+	DDSWriter<SampleType> create_new_writer(
+			const DDSTopic<SampleType> &dds_topic,
+			DDSWriterListener<SampleType>* the_listener = NULL,
+			const dds::core::status::StatusMask& mask = dds::core::status::StatusMask::all()) const
+	{
+		try {
+			return DDSWriter<SampleType>(create_publisher(), dds_topic, create_writer_qos(), the_listener, mask);
+		} catch(dds::core::Error &error) {
+			std::cerr << error.what() << std::endl;
+		}
+		return DDSWriter<SampleType>(nullptr);
+	}
 
 	Smart::StatusCode reconnect(
-			DynamicDataWriter & dds_writer,
-			const DynamicDataTopic & dds_topic,
+			DDSWriter<SampleType> & dds_writer,
+			const DDSTopic<SampleType> & dds_topic,
 			const Smart::Duration & timeout = Smart::Duration::max(),
-			DynamicDataWriterListener* the_listener = NULL,
-			const dds::core::status::StatusMask& mask = dds::core::status::StatusMask::all());
+			DDSWriterListener<SampleType>* the_listener = NULL,
+			const dds::core::status::StatusMask& mask = dds::core::status::StatusMask::all())
+	{
+		// reset the connection guard
+		connection_guard.trigger_value(false);
+
+		// first we reset the writer with the new attributes including "this" as the listener pointer (see last parameter)
+		dds_writer = create_new_writer(dds_topic, this);
+		if(dds_writer.is_nil()) {
+			return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
+		}
+
+		auto status = wait_for_guard(timeout);
+		if(status == Smart::StatusCode::SMART_OK) {
+			try {
+				// now we reset the listener pointer
+				dds_writer.listener(the_listener, mask);
+				return Smart::StatusCode::SMART_OK;
+			} catch(dds::core::Error &error) {
+				std::cerr << error.what() << std::endl;
+				status = Smart::StatusCode::SMART_ERROR_COMMUNICATION;
+			}
+		}
+		// make sure the writer is in a consistent disconnected state at the end event in presence of errors
+		reset(dds_writer);
+		return status;
+	}
 };
 
 } /* namespace SmartDDS */
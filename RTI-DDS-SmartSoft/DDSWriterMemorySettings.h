@@ -0,0 +1,93 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_DDSWRITERMEMORYSETTINGS_H_
+#define RTIDDSSMARTSOFT_DDSWRITERMEMORYSETTINGS_H_
+
+#include <cstdint>
+#include <cstddef>
+
+namespace SmartDDS {
+
+/** The memory-manager settings of a writer (see the pattern QoS classes for the defaults of each pattern).
+ *
+ *  RTI pre-allocates the writer's history buffers up to the pool_buffer_max_size, larger samples
+ *  are allocated dynamically on each write. Too large values waste memory for small samples.
+ */
+struct DDSWriterMemorySettings {
+	// the maximal serialized sample size that is served from the pre-allocated pool (-1 means unlimited)
+	int32_t pool_buffer_max_size = 32768;
+	// every n-th written sample is measured to collect the pool statistics (zero disables the measurement)
+	uint32_t sampling_period = 0;
+	// writers created later use the largest measured sample size for their pool; this only affects the
+	// client patterns (whose writers are created on each connect), the server patterns create their
+	// writers once within their constructor and keep the initial pool_buffer_max_size
+	bool adaptive = false;
+
+	DDSWriterMemorySettings() = default;
+	DDSWriterMemorySettings(const int32_t &pool_buffer_max_size, const uint32_t &sampling_period = 0, const bool &adaptive = false)
+	:	pool_buffer_max_size(pool_buffer_max_size)
+	,	sampling_period(sampling_period)
+	,	adaptive(adaptive)
+	{  }
+};
+
+/** The statistics of the measured samples of a writer (only collected if the sampling period is set)
+ *
+ *  The middleware does not report its actual pool usage, so the hits and misses are estimated by
+ *  comparing the serialized size of each measured sample with the pool buffer size (i.e. the
+ *  samples that are not measured are not counted).
+ */
+struct DDSWriterMemoryStatistics {
+	uint64_t measured_samples = 0;
+	// measured samples that (presumably) fit into the pre-allocated pool buffers
+	uint64_t estimated_pool_hits = 0;
+	// measured samples that (presumably) required a dynamic allocation
+	uint64_t estimated_pool_misses = 0;
+	size_t max_sample_size = 0;
+	// the pool buffer size used for the most recently created writer
+	int32_t pool_buffer_max_size = 0;
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_DDSWRITERMEMORYSETTINGS_H_ */
@@ -45,16 +45,20 @@
 
 #include <map>
 #include <mutex>
+#include <future>
 #include <memory>
 
 #include "RTI-DDS-SmartSoft/Component.h"
+#include "RTI-DDS-SmartSoft/AsyncConnector.h"
 
 #include "RTI-DDS-SmartSoft/EventResult.h"
 #include "RTI-DDS-SmartSoft/EventPatternQoS.h"
 #include "RTI-DDS-SmartSoft/EventActivationDecorator.h"
 
 #include "RTI-DDS-SmartSoft/DDSReaderConnector.h"
+#include "RTI-DDS-SmartSoft/DDSWaitSetPool.h"
 #include "RTI-DDS-SmartSoft/DDSWriterConnector.h"
+#include "RTI-DDS-SmartSoft/DDSTypeTraits.h"
 
 #include <smartIEventClientPattern_T.h>
 
@@ -76,32 +80,40 @@ public:
 template<class ActivationType, class EventType>
 class EventClientPattern
 :	public Smart::IEventClientPattern<ActivationType,EventType>
-,	public dds::sub::NoOpDataReaderListener<dds::core::xtypes::DynamicData>
+,	public DDSReaderListener<typename DDSTypeTraits<EventType>::SampleType>
 {
 private:
+	// the activation channel is always DynamicData (it is decorated by the EventActivationDecorator)
+	using EventTraits = DDSTypeTraits<EventType>;
+	using EventSampleType = typename EventTraits::SampleType;
 
 	Component *component;
 
 	std::recursive_mutex client_mutex;
+	// the background connect of connectAsync(...), which is completed before disconnecting
+	AsyncConnector async_connector;
 	std::map<CorrelationId, std::shared_ptr<EventResult<EventType>>> event_cache;
 
 	EventActivationDecorator activation_decorator;
 
 	// this helpers allow checking if a remote end-point actually responds during a connection phase (see connect(...) method)
-	DDSWriterConnector dds_writer_connector;
-	DDSReaderConnector dds_reader_connector;
+	DDSWriterConnector<DynamicDataSample> dds_writer_connector;
+	DDSReaderConnector<EventSampleType> dds_reader_connector;
 
-	dds::topic::Topic<dds::core::xtypes::DynamicData> dds_activation_topic;
-	dds::pub::DataWriter<dds::core::xtypes::DynamicData> dds_activation_writer;
+	DynamicDataTopic dds_activation_topic;
+	DynamicDataWriter dds_activation_writer;
 
-	dds::topic::Topic<dds::core::xtypes::DynamicData> dds_event_topic;
-	dds::topic::ContentFilteredTopic<dds::core::xtypes::DynamicData> dds_filtered_event_topic;
-	dds::sub::DataReader<dds::core::xtypes::DynamicData> dds_filtered_event_reader;
+	DDSTopic<EventSampleType> dds_event_topic;
+	DDSFilteredTopic<EventSampleType> dds_filtered_event_topic;
+	DDSReader<EventSampleType> dds_filtered_event_reader;
 
 	dds::core::cond::GuardCondition disconnected_guard;
 	dds::core::cond::GuardCondition nonblocking_guard;
 
-    void on_liveliness_changed(dds::sub::DataReader<dds::core::xtypes::DynamicData>&,
+	// the WaitSets of getEvent(...) and getNextEvent(...) with the above two guards attached
+	DDSWaitSetPool wait_sets;
+
+    void on_liveliness_changed(DDSReader<EventSampleType>&,
        const dds::core::status::LivelinessChangedStatus &status)
     {
     	if(status.alive_count() == 0) {
@@ -110,7 +122,7 @@ private:
     		disconnected_guard.trigger_value(false);
     	}
     }
-    void on_data_available(dds::sub::DataReader<dds::core::xtypes::DynamicData> &reader)
+    void on_data_available(DDSReader<EventSampleType> &reader)
     {
     	// do not grab the mutex if client is in the process of shutting down or disconnecting
 		if(this->is_shutting_down() || disconnected_guard.trigger_value() == true)
@@ -127,7 +139,7 @@ private:
 				CorrelationId related_id = CorrelationId::createRelatedId(event.info());
 				input.event_id = std::make_shared<CorrelationId>(related_id);
 
-				convert(event.data(), input.event);
+				EventTraits::fromSample(event.data(), input.event);
 
 				// first we first copy the new event into the internal cache
 				auto event_it = event_cache.find(related_id);
@@ -154,14 +166,15 @@ public:
 	EventClientPattern(Component* component)
 	:	Smart::IEventClientPattern<ActivationType, EventType>(component)
 	,	component(component)
-	,	activation_decorator(dds_type<ActivationType>())
-	,	dds_writer_connector(component, EventPatternQoS::getActivationTopicQoS())
+	,	activation_decorator(DDSTypeRegistry::get<ActivationType>())
+	,	dds_writer_connector(component, EventPatternQoS::getActivationTopicQoS(), EventPatternQoS::getActivationWriterMemorySettings())
 	,	dds_reader_connector(component, EventPatternQoS::getEventTopicQoS())
 	,	dds_activation_topic(nullptr)
 	,	dds_activation_writer(nullptr)
 	,	dds_event_topic(nullptr)
 	,	dds_filtered_event_topic(nullptr)
 	,	dds_filtered_event_reader(nullptr)
+	,	wait_sets({disconnected_guard, nonblocking_guard})
 	{
 		// by default, the client initializes in the disconnected state
 		disconnected_guard.trigger_value(true);
@@ -182,14 +195,15 @@ public:
 	EventClientPattern(Component* component, const std::string& server, const std::string& service)
 	:	Smart::IEventClientPattern<ActivationType, EventType>(component, server, service)
 	,	component(component)
-	,	activation_decorator(dds_type<ActivationType>())
-	,	dds_writer_connector(component, EventPatternQoS::getActivationTopicQoS())
+	,	activation_decorator(DDSTypeRegistry::get<ActivationType>())
+	,	dds_writer_connector(component, EventPatternQoS::getActivationTopicQoS(), EventPatternQoS::getActivationWriterMemorySettings())
 	,	dds_reader_connector(component, EventPatternQoS::getEventTopicQoS())
 	,	dds_activation_topic(nullptr)
 	,	dds_activation_writer(nullptr)
 	,	dds_event_topic(nullptr)
 	,	dds_filtered_event_topic(nullptr)
 	,	dds_filtered_event_reader(nullptr)
+	,	wait_sets({disconnected_guard, nonblocking_guard})
 	{
 		// by default, the client initializes in the disconnected state
 		disconnected_guard.trigger_value(true);
@@ -231,6 +245,9 @@ public:
      */
     virtual Smart::StatusCode connect(const std::string& server, const std::string& service) override
     {
+    	// a pending connectAsync(...) is completed first (it holds the client mutex while connecting)
+    	async_connector.wait();
+
     	std::unique_lock<std::recursive_mutex> client_lock(client_mutex);
 
     	// we by default disconnect the previous connection
@@ -244,14 +261,16 @@ public:
 
 		// the dynamic DDS types are determined using external template methods
 		auto dds_activation_type = activation_decorator.getDecoratedDDSType();
-		auto dds_event_type = dds_type<EventType>();
 
 		try {
 			// if the related event server is in the same component, then the topic is already defined and we can simply reuse it
 			dds_activation_topic = component->DDS().findOrCreateTopic(activationTopicName, dds_activation_type);
-			dds_event_topic = component->DDS().findOrCreateTopic(eventTopicName, dds_event_type);
+			dds_event_topic = EventTraits::findOrCreateTopic(component->DDS(), eventTopicName);
 
-			auto timeout = std::chrono::seconds(1);
+			dds_writer_connector.setQosProfile(DDSQosProfiles::findWriterProfile("EventPattern", component->getName(), server, service));
+			dds_reader_connector.setQosProfile(DDSQosProfiles::findReaderProfile("EventPattern", component->getName(), server, service));
+
+			auto timeout = component->getConnectionTimeout();
 			auto connection_status = dds_writer_connector.reconnect(dds_activation_writer, dds_activation_topic, timeout);
 
 			if(connection_status != Smart::StatusCode::SMART_OK) {
@@ -283,6 +302,27 @@ public:
     	return Smart::StatusCode::SMART_ERROR;
     }
 
+    /** Asynchronously connect this service requestor to the denoted service provider.
+     *
+     *  This method returns immediately and performs the connect(server, service) call in the
+     *  background. This allows all client ports of a component to establish their connections
+     *  in parallel (instead of one after another) and to collect the results afterwards.
+     *  The maximal waiting time of each connection attempt is configured by the component
+     *  (see Component::setConnectionTimeout). A pending background connect is completed
+     *  before disconnect() proceeds (which also applies to the destructor).
+     *
+     * @param server     name of the server (i.e. the component-name to connect to)
+     * @param service    name of the service (i.e. the port-name of the component to connect to)
+     *
+     * @return a future providing the status code of the connect(server, service) call
+     */
+    std::future<Smart::StatusCode> connectAsync(const std::string& server, const std::string& service)
+    {
+    	return async_connector.start([this, server, service]() {
+    		return this->connect(server, service);
+    	});
+    }
+
     /** Disconnect the service requestor from the service provider.
      *
      *  It is no problem to change the connection to a service provider at any
@@ -302,6 +342,9 @@ public:
     	// first thing is to change the disconnected guard to true so no blocking calls will be used from here on
     	disconnected_guard.trigger_value(true);
 
+		// a pending connectAsync(...) is completed first (the connection is then closed below)
+		async_connector.wait();
+
 		std::unique_lock<std::recursive_mutex> client_lock(client_mutex);
 
 		for(auto event: event_cache) {
@@ -579,19 +622,18 @@ public:
     		// this copies the internal shared pointer (which prevents its destruction as long as we have a copy here)
     		auto event_result_ptr = foundEventIt->second;
 
-			dds::core::cond::WaitSet wait_set;
-			wait_set += disconnected_guard;
-			wait_set += nonblocking_guard;
+			// the pooled WaitSet already contains the disconnected and non-blocking guards
+			auto wait_set = wait_sets.acquire();
 
 			// these two guards are specific to the given EventId
-			wait_set += event_result_ptr->getDeactivationGuard();
-			wait_set += event_result_ptr->getEventGuard();
+			wait_set.attach(event_result_ptr->getDeactivationGuard());
+			wait_set.attach(event_result_ptr->getEventGuard());
 
 			// release the lock to ensure that the patterns remains responsive while this method waits
 			client_lock.unlock();
 
 			// wait for one of the provided conditions to become true
-			auto active_conditions = wait_set.wait(timeout);
+			const auto &active_conditions = wait_set.wait(timeout);
 
 			client_lock.lock();
 
@@ -714,26 +756,28 @@ public:
     			}
     		}
 
-			dds::core::cond::WaitSet wait_set;
-			wait_set += disconnected_guard;
-			wait_set += nonblocking_guard;
+			// the pooled WaitSet already contains the disconnected and non-blocking guards
+			auto wait_set = wait_sets.acquire();
 
 			// the next two guards are specific to the given EventId
-			wait_set += event_result_ptr->getDeactivationGuard();
+			wait_set.attach(event_result_ptr->getDeactivationGuard());
 
-			// each call of getNextEvent() creates an own individual guard that is registered with the current event
-			dds::core::cond::GuardCondition next_event_guard;
-			wait_set += next_event_guard;
+			// each call of getNextEvent() uses an own individual guard that is registered with the current event
+			// (the guard belongs to the pooled WaitSet, so it is reused by later calls)
+			auto next_event_guard = wait_set.attachGuard();
 			event_result_ptr->addNextEventGuard(next_event_guard);
 
 			// release the lock to ensure that the patterns remains responsive while this method waits
 			client_lock.unlock();
 
 			// wait for one of the provided conditions to become true
-			auto active_conditions = wait_set.wait(timeout);
+			const auto &active_conditions = wait_set.wait(timeout);
 
 			client_lock.lock();
 
+			// the guard is unregistered on every return path, as it will be reused by the next call
+			event_result_ptr->removeNextEventGuard(next_event_guard);
+
 			if(active_conditions.size() == 0) {
 				// if no specified conditions are active, then the only thing that could have happened is a timeout
 				return Smart::StatusCode::SMART_TIMEOUT;
@@ -45,6 +45,8 @@
 
 #include <dds/dds.hpp>
 
+#include "RTI-DDS-SmartSoft/DDSWriterMemorySettings.h"
+
 namespace SmartDDS {
 
 class EventPatternQoS {
@@ -91,6 +93,16 @@ public:
 		topic_qos << dds::core::policy::Liveliness::Automatic();
 		return topic_qos;
 	}
+
+	static DDSWriterMemorySettings getActivationWriterMemorySettings() {
+		// activations only contain the (typically small) activation parameters and some meta-data
+		return DDSWriterMemorySettings(4096);
+	}
+
+	static DDSWriterMemorySettings getEventWriterMemorySettings() {
+		// samples up to 32 KB are served from the writer's pre-allocated pool (larger samples are allocated on demand)
+		return DDSWriterMemorySettings(32768);
+	}
 };
 
 } /* namespace SmartDDS */
@@ -115,6 +115,10 @@ public:
 		std::unique_lock<std::recursive_mutex> event_lock(event_mutex);
 		next_event_guards.push_back(guard);
 	}
+	void removeNextEventGuard(const dds::core::cond::GuardCondition &guard) {
+		std::unique_lock<std::recursive_mutex> event_lock(event_mutex);
+		next_event_guards.remove(guard);
+	}
 	inline EventType consumeNextEvent(const dds::core::cond::GuardCondition &guard) {
 		std::unique_lock<std::recursive_mutex> event_lock(event_mutex);
 		next_event_guards.remove(guard);
@@ -53,6 +53,7 @@
 
 #include "RTI-DDS-SmartSoft/DDSReaderConnector.h"
 #include "RTI-DDS-SmartSoft/DDSWriterConnector.h"
+#include "RTI-DDS-SmartSoft/DDSTypeTraits.h"
 
 #include <smartIEventServerPattern_T.h>
 
@@ -64,6 +65,10 @@ class EventServerPattern
 ,	public DynamicDataReaderListener
 {
 private:
+	// the activation channel is always DynamicData (it is decorated by the EventActivationDecorator)
+	using EventTraits = DDSTypeTraits<EventType>;
+	using EventSampleType = typename EventTraits::SampleType;
+
 	Component* component;
 
 	std::mutex server_mutex;
@@ -72,14 +77,14 @@ private:
 
 	EventActivationDecorator activation_decorator;
 
-	DDSReaderConnector dds_reader_connector;
-	DDSWriterConnector dds_writer_connector;
+	DDSReaderConnector<DynamicDataSample> dds_reader_connector;
+	DDSWriterConnector<EventSampleType> dds_writer_connector;
 
 	DynamicDataTopic dds_activation_topic;
 	DynamicDataReader dds_activation_reader;
 
-	DynamicDataTopic dds_event_topic;
-	DynamicDataWriter dds_event_writer;
+	DDSTopic<EventSampleType> dds_event_topic;
+	DDSWriter<EventSampleType> dds_event_writer;
 
 	virtual void on_data_available(DynamicDataReader& reader) override
 	{
@@ -145,9 +150,9 @@ public:
 	EventServerPattern(Component* component, const std::string& serviceName, IEventTestHandlerPtr testHandler)
 	:	IEventServerBase(component, serviceName, testHandler)
 	,	component(component)
-	,	activation_decorator(dds_type<ActivationType>())
+	,	activation_decorator(DDSTypeRegistry::get<ActivationType>())
 	,	dds_reader_connector(component, EventPatternQoS::getActivationTopicQoS())
-	,	dds_writer_connector(component, EventPatternQoS::getEventTopicQoS())
+	,	dds_writer_connector(component, EventPatternQoS::getEventTopicQoS(), EventPatternQoS::getEventWriterMemorySettings())
 	,	dds_activation_topic(nullptr)
 	,	dds_activation_reader(nullptr)
 	,	dds_event_topic(nullptr)
@@ -158,11 +163,13 @@ public:
 
 		// the dynamic DDS types are determined using external template methods
 		auto dds_activation_type = activation_decorator.getDecoratedDDSType();
-		auto dds_event_type = dds_type<EventType>();
 
 		// create the two topics
 		dds_activation_topic = component->DDS().findOrCreateTopic(activationTopicName, dds_activation_type);
-		dds_event_topic = component->DDS().findOrCreateTopic(eventTopicName, dds_event_type);
+		dds_event_topic = EventTraits::findOrCreateTopic(component->DDS(), eventTopicName);
+
+		dds_reader_connector.setQosProfile(DDSQosProfiles::findReaderProfile("EventPattern", component->getName(), component->getName(), serviceName));
+		dds_writer_connector.setQosProfile(DDSQosProfiles::findWriterProfile("EventPattern", component->getName(), component->getName(), serviceName));
 
 		dds_activation_reader = dds_reader_connector.create_new_reader(dds_activation_topic, this);
 		dds_event_writer = dds_writer_connector.create_new_writer(dds_event_topic);
@@ -203,7 +210,9 @@ public:
 						// set the related event-activation ID as related sample ID
 						params.related_sample_identity(event_activation.getEventId());
     					// now write the actual event to the associated client
-    					dds_event_writer->write(serialize(event), params);
+    					auto event_sample = EventTraits::toSample(event);
+    					dds_event_writer->write(event_sample, params);
+    					dds_writer_connector.observe(event_sample);
     				} catch (std::exception &ex) {
 						std::cerr << ex.what() << std::endl;
 						return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
@@ -214,6 +223,14 @@ public:
 
     	return Smart::StatusCode::SMART_OK;
     }
+
+    /** returns the statistics of the measured samples of the writer (only collected if a
+     *  sampling period is configured within the writer memory settings of the pattern QoS)
+     */
+    DDSWriterMemoryStatistics getWriterMemoryStatistics() const
+    {
+    	return dds_writer_connector.getMemoryStatistics();
+    }
 };
 
 } /* namespace SmartDDS */
@@ -0,0 +1,147 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_LOCALPUSHSERVICE_H_
+#define RTIDDSSMARTSOFT_LOCALPUSHSERVICE_H_
+
+#include <memory>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include "RTI-DDS-SmartSoft/LocalServiceRegistry.h"
+
+namespace SmartDDS {
+
+template <class DataType>
+class LocalPushClient : public LocalServiceClient {
+public:
+	virtual ~LocalPushClient() = default;
+
+	// the same (immutable) data object is handed over to all local subscribers;
+	// this is called while the service is locked, so user code must be deferred (see LocalDispatcher)
+	virtual void onLocalUpdate(const std::shared_ptr<const DataType> &data) = 0;
+};
+
+/** The local (in-process) delivery path of a PushServerPattern (see LocalServiceRegistry).
+ */
+template <class DataType>
+class LocalPushService : public LocalService {
+private:
+	struct Subscription {
+		LocalPushClient<DataType> *client;
+		unsigned int prescale;
+		unsigned int update_counter;
+		std::chrono::steady_clock::duration minimum_separation;
+		std::chrono::steady_clock::time_point last_update;
+	};
+	std::vector<Subscription> subscriptions;
+
+public:
+	LocalPushService(const std::shared_ptr<LocalDispatcherPool> &pool)
+	:	LocalService(pool)
+	{  }
+	virtual ~LocalPushService() = default;
+
+	bool subscribe(LocalPushClient<DataType> *client, const unsigned int &prescale,
+			const std::chrono::steady_clock::duration &minimum_separation = std::chrono::steady_clock::duration::zero())
+	{
+		std::unique_lock<std::shared_timed_mutex> service_lock(service_mutex);
+		if(!active) {
+			return false;
+		}
+		auto subscription_it = std::find_if(subscriptions.begin(), subscriptions.end(),
+				[client](const Subscription &subscription) { return subscription.client == client; });
+		if(subscription_it != subscriptions.end()) {
+			subscription_it->prescale = prescale;
+			subscription_it->update_counter = 0;
+			subscription_it->minimum_separation = minimum_separation;
+			subscription_it->last_update = std::chrono::steady_clock::time_point();
+		} else {
+			subscriptions.push_back(Subscription{client, prescale, 0, minimum_separation, std::chrono::steady_clock::time_point()});
+		}
+		return true;
+	}
+
+	void unsubscribe(LocalPushClient<DataType> *client)
+	{
+		std::unique_lock<std::shared_timed_mutex> service_lock(service_mutex);
+		subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(),
+				[client](const Subscription &subscription) { return subscription.client == client; }),
+				subscriptions.end());
+	}
+
+	/** delivers the data to all local subscribers taking into account their individual prescale factors
+	 *
+	 *  The subscribers only queue the shared data, so slow subscribers do not block the caller.
+	 *  The caller (i.e. PushServerPattern::put) serializes the calls of this method, which is why the
+	 *  update counters can be modified while only holding the shared lock.
+	 */
+	void put(const DataType &data)
+	{
+		std::shared_lock<std::shared_timed_mutex> service_lock(service_mutex);
+		if(!active || subscriptions.empty()) {
+			return;
+		}
+		// the data is copied (at most) once and then shared by all local subscribers
+		std::shared_ptr<const DataType> shared_data;
+		auto now = std::chrono::steady_clock::now();
+		for(auto &subscription: subscriptions) {
+			// a newly subscribed client gets the next update and then every n-th update (same as the CorrelationIdFilter)
+			if(subscription.update_counter++ % subscription.prescale != 0) {
+				continue;
+			}
+			// rate-based subscriptions additionally skip updates that follow the last update too closely
+			if(now - subscription.last_update >= subscription.minimum_separation) {
+				subscription.last_update = now;
+				if(!shared_data) {
+					shared_data = std::make_shared<const DataType>(data);
+				}
+				subscription.client->onLocalUpdate(shared_data);
+			}
+		}
+	}
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_LOCALPUSHSERVICE_H_ */
@@ -0,0 +1,131 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_LOCALQUERYSERVICE_H_
+#define RTIDDSSMARTSOFT_LOCALQUERYSERVICE_H_
+
+#include <mutex>
+#include <memory>
+#include <functional>
+
+#include "RTI-DDS-SmartSoft/CorrelationId.h"
+#include "RTI-DDS-SmartSoft/LocalServiceRegistry.h"
+#include "RTI-DDS-SmartSoft/QueryClientAnswerTrigger.h"
+
+namespace SmartDDS {
+
+template <class RequestType, class AnswerType>
+class LocalQueryHandler {
+public:
+	virtual ~LocalQueryHandler() = default;
+
+	// the answer is later provided through the given answer-trigger (instead of the DDS reply topic)
+	virtual void handleLocalQuery(
+			const std::shared_ptr<CorrelationId> &query_id,
+			const RequestType &request,
+			const std::shared_ptr<QueryClientAnswerTrigger<AnswerType>> &answer_trigger) = 0;
+};
+
+/** The local (in-process) delivery path of a QueryServerPattern (see LocalServiceRegistry).
+ *
+ *  The request is copied once and then handed over to the server's handler within the service's
+ *  dispatcher (see LocalDispatcher). Requests that are not yet dispatched when the service
+ *  is deactivated are discarded through their answer-trigger.
+ */
+template <class RequestType, class AnswerType>
+class LocalQueryService : public LocalService {
+private:
+	LocalQueryHandler<RequestType, AnswerType> *handler;
+
+	std::mutex id_mutex;
+	rti::core::SequenceNumber next_sequence_number;
+
+public:
+	// the generated query IDs only need to be unique within this service (i.e. for the connected clients)
+	LocalQueryService(const std::shared_ptr<LocalDispatcherPool> &pool, LocalQueryHandler<RequestType, AnswerType> *handler)
+	:	LocalService(pool)
+	,	handler(handler)
+	,	next_sequence_number(rti::core::SequenceNumber::zero())
+	{  }
+	virtual ~LocalQueryService() = default;
+
+	/** dispatches the request to the local query server
+	 *  @param client_id       the (unique) ID of the client connection, which becomes the connection part of the query ID
+	 *                         (so that e.g. the per-client ordering of the WorkStealingQueryHandler distinguishes the local clients)
+	 *  @param register_query  (optional) is called with the generated query ID before the request is dispatched
+	 *                         (the local server might answer before this method returns)
+	 *                         and must not call back into this service
+	 *  @return the query ID or nullptr if the service is not active anymore
+	 */
+	std::shared_ptr<CorrelationId> query(
+			const ConnectionId &client_id,
+			const RequestType &request,
+			const std::shared_ptr<QueryClientAnswerTrigger<AnswerType>> &answer_trigger,
+			const std::function<void(const std::shared_ptr<CorrelationId>&)> &register_query = nullptr)
+	{
+		std::shared_lock<std::shared_timed_mutex> service_lock(service_mutex);
+		if(!active) {
+			return nullptr;
+		}
+		std::unique_lock<std::mutex> id_lock(id_mutex);
+		next_sequence_number++;
+		auto query_id = std::make_shared<CorrelationId>(client_id, next_sequence_number);
+		id_lock.unlock();
+
+		if(register_query) {
+			register_query(query_id);
+		}
+		// the handler outlives the dispatcher (which is stopped on deactivate())
+		auto local_handler = handler;
+		auto shared_request = std::make_shared<const RequestType>(request);
+		server_dispatcher.post([local_handler, query_id, shared_request, answer_trigger]() {
+			local_handler->handleLocalQuery(query_id, *shared_request, answer_trigger);
+		}, [answer_trigger]() {
+			answer_trigger->triggerDiscard();
+		});
+		return query_id;
+	}
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_LOCALQUERYSERVICE_H_ */
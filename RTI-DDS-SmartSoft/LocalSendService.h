@@ -0,0 +1,96 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_LOCALSENDSERVICE_H_
+#define RTIDDSSMARTSOFT_LOCALSENDSERVICE_H_
+
+#include <memory>
+
+#include <smartStatusCode.h>
+
+#include "RTI-DDS-SmartSoft/LocalServiceRegistry.h"
+
+namespace SmartDDS {
+
+template <class DataType>
+class LocalSendHandler {
+public:
+	virtual ~LocalSendHandler() = default;
+	virtual void handleLocalSend(const DataType &data) = 0;
+};
+
+/** The local (in-process) delivery path of a SendServerPattern (see LocalServiceRegistry).
+ *
+ *  The data is copied once and then handed over to the server's handler within the service's
+ *  dispatcher (see LocalDispatcher), so the sending thread is not blocked by the handler.
+ */
+template <class DataType>
+class LocalSendService : public LocalService {
+private:
+	LocalSendHandler<DataType> *handler;
+
+public:
+	LocalSendService(const std::shared_ptr<LocalDispatcherPool> &pool, LocalSendHandler<DataType> *handler)
+	:	LocalService(pool)
+	,	handler(handler)
+	{  }
+	virtual ~LocalSendService() = default;
+
+	Smart::StatusCode send(const DataType &data)
+	{
+		std::shared_lock<std::shared_timed_mutex> service_lock(service_mutex);
+		if(!active) {
+			return Smart::StatusCode::SMART_DISCONNECTED;
+		}
+		// the handler outlives the dispatcher (which is stopped on deactivate())
+		auto local_handler = handler;
+		auto shared_data = std::make_shared<const DataType>(data);
+		server_dispatcher.post([local_handler, shared_data]() {
+			local_handler->handleLocalSend(*shared_data);
+		});
+		return Smart::StatusCode::SMART_OK;
+	}
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_LOCALSENDSERVICE_H_ */
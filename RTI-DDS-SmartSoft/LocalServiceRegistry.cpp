@@ -0,0 +1,308 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#include <algorithm>
+
+#include "RTI-DDS-SmartSoft/LocalServiceRegistry.h"
+
+namespace SmartDDS {
+
+LocalDispatcherPool::LocalDispatcherPool(const size_t &max_threads)
+:	state(std::make_shared<PoolState>())
+,	max_threads(max_threads)
+{  }
+
+LocalDispatcherPool::~LocalDispatcherPool()
+{
+	std::deque<Task> dropped;
+	std::vector<std::thread> stopped_threads;
+	{
+		std::unique_lock<std::mutex> pool_lock(state->pool_mutex);
+		state->stopped = true;
+		dropped.swap(state->tasks);
+		stopped_threads.swap(threads);
+	}
+	state->pool_cond.notify_all();
+	dropped.clear();
+
+	for(auto &stopped_thread: stopped_threads) {
+		if(stopped_thread.get_id() == std::this_thread::get_id()) {
+			// destroyed from within a task, the thread ends after that task (it owns a reference to the state)
+			stopped_thread.detach();
+		} else {
+			stopped_thread.join();
+		}
+	}
+}
+
+bool LocalDispatcherPool::execute(const Task &task)
+{
+	{
+		std::unique_lock<std::mutex> pool_lock(state->pool_mutex);
+		if(state->stopped) {
+			return false;
+		}
+		state->tasks.push_back(task);
+		if(state->idle_threads < state->tasks.size() && (max_threads == 0 || threads.size() < max_threads)) {
+			threads.push_back(std::thread(&LocalDispatcherPool::workerRunnable, state));
+		}
+	}
+	state->pool_cond.notify_one();
+	return true;
+}
+
+size_t LocalDispatcherPool::getNumberOfThreads()
+{
+	std::unique_lock<std::mutex> pool_lock(state->pool_mutex);
+	return threads.size();
+}
+
+void LocalDispatcherPool::workerRunnable(std::shared_ptr<PoolState> state)
+{
+	std::unique_lock<std::mutex> pool_lock(state->pool_mutex);
+	while(!state->stopped) {
+		if(state->tasks.empty()) {
+			state->idle_threads++;
+			state->pool_cond.wait(pool_lock);
+			state->idle_threads--;
+			continue;
+		}
+		auto task = std::move(state->tasks.front());
+		state->tasks.pop_front();
+
+		pool_lock.unlock();
+		task();
+		pool_lock.lock();
+	}
+}
+
+LocalDispatcher::LocalDispatcher(const std::shared_ptr<LocalDispatcherPool> &pool, const size_t &max_pending)
+:	state(std::make_shared<DispatcherState>())
+,	max_pending(max_pending)
+,	pool(pool)
+{  }
+
+LocalDispatcher::~LocalDispatcher()
+{
+	stop();
+}
+
+void LocalDispatcher::setMaxPending(const size_t &max_pending)
+{
+	std::unique_lock<std::mutex> dispatcher_lock(state->dispatcher_mutex);
+	this->max_pending = max_pending;
+}
+
+bool LocalDispatcher::post(const Delivery &deliver, const Delivery &discard)
+{
+	std::deque<PendingDelivery> dropped;
+	bool schedule = false;
+	{
+		std::unique_lock<std::mutex> dispatcher_lock(state->dispatcher_mutex);
+		if(state->stopped) {
+			dispatcher_lock.unlock();
+			if(discard) {
+				discard();
+			}
+			return false;
+		}
+		state->deliveries.push_back(PendingDelivery{deliver, discard});
+		while(max_pending > 0 && state->deliveries.size() > max_pending) {
+			dropped.push_back(std::move(state->deliveries.front()));
+			state->deliveries.pop_front();
+		}
+		// at most one task per dispatcher is in the pool, which keeps the deliveries in order
+		if(!state->scheduled) {
+			state->scheduled = true;
+			schedule = true;
+		}
+	}
+	if(schedule) {
+		auto dispatcher_state = state;
+		if(!pool->execute([dispatcher_state]() { LocalDispatcher::executeDeliveries(dispatcher_state); })) {
+			// the pool is already destroyed (i.e. the component is shut down)
+			std::unique_lock<std::mutex> dispatcher_lock(state->dispatcher_mutex);
+			state->scheduled = false;
+			while(!state->deliveries.empty()) {
+				dropped.push_back(std::move(state->deliveries.front()));
+				state->deliveries.pop_front();
+			}
+		}
+	}
+	// the discard functions are called outside of the lock (they might call back into the dispatcher)
+	discardAll(dropped);
+	return true;
+}
+
+void LocalDispatcher::clear()
+{
+	std::deque<PendingDelivery> dropped;
+	{
+		std::unique_lock<std::mutex> dispatcher_lock(state->dispatcher_mutex);
+		dropped.swap(state->deliveries);
+	}
+	discardAll(dropped);
+}
+
+void LocalDispatcher::stop()
+{
+	std::deque<PendingDelivery> dropped;
+	{
+		std::unique_lock<std::mutex> dispatcher_lock(state->dispatcher_mutex);
+		state->stopped = true;
+		dropped.swap(state->deliveries);
+		// a delivery that stops its own dispatcher would otherwise wait for itself
+		while(state->running_thread != std::thread::id() && state->running_thread != std::this_thread::get_id()) {
+			state->dispatcher_cond.wait(dispatcher_lock);
+		}
+	}
+	discardAll(dropped);
+}
+
+void LocalDispatcher::executeDeliveries(std::shared_ptr<DispatcherState> state)
+{
+	std::unique_lock<std::mutex> dispatcher_lock(state->dispatcher_mutex);
+	while(!state->stopped && !state->deliveries.empty()) {
+		auto delivery = std::move(state->deliveries.front());
+		state->deliveries.pop_front();
+		state->running_thread = std::this_thread::get_id();
+
+		dispatcher_lock.unlock();
+		delivery.deliver();
+		dispatcher_lock.lock();
+
+		state->running_thread = std::thread::id();
+		state->dispatcher_cond.notify_all();
+	}
+	state->scheduled = false;
+}
+
+void LocalDispatcher::discardAll(std::deque<PendingDelivery> &deliveries)
+{
+	for(auto &delivery: deliveries) {
+		if(delivery.discard) {
+			delivery.discard();
+		}
+	}
+	deliveries.clear();
+}
+
+LocalService::LocalService(const std::shared_ptr<LocalDispatcherPool> &pool)
+:	active(true)
+,	server_dispatcher(pool)
+{  }
+
+bool LocalService::isActive() const
+{
+	std::shared_lock<std::shared_timed_mutex> service_lock(service_mutex);
+	return active;
+}
+
+bool LocalService::attach(LocalServiceClient *client)
+{
+	std::unique_lock<std::shared_timed_mutex> service_lock(service_mutex);
+	if(!active) {
+		return false;
+	}
+	if(std::find(clients.begin(), clients.end(), client) == clients.end()) {
+		clients.push_back(client);
+	}
+	return true;
+}
+
+void LocalService::detach(LocalServiceClient *client)
+{
+	std::unique_lock<std::shared_timed_mutex> service_lock(service_mutex);
+	clients.erase(std::remove(clients.begin(), clients.end(), client), clients.end());
+}
+
+void LocalService::deactivate()
+{
+	std::unique_lock<std::shared_timed_mutex> service_lock(service_mutex);
+	active = false;
+	for(auto client: clients) {
+		client->onLocalServiceDisconnect();
+	}
+	clients.clear();
+	service_lock.unlock();
+
+	// no further requests are posted from here on (see active flag)
+	server_dispatcher.stop();
+}
+
+LocalServiceRegistry::LocalServiceRegistry()
+:	enabled(true)
+{  }
+
+LocalServiceRegistry& LocalServiceRegistry::instance()
+{
+	static LocalServiceRegistry registry;
+	return registry;
+}
+
+void LocalServiceRegistry::setEnabled(const bool enabled)
+{
+	this->enabled = enabled;
+}
+
+bool LocalServiceRegistry::isEnabled() const
+{
+	return enabled;
+}
+
+void LocalServiceRegistry::registerService(const ServiceKey &service_key, const std::shared_ptr<LocalService> &service)
+{
+	std::unique_lock<std::mutex> registry_lock(registry_mutex);
+	services[service_key] = service;
+}
+
+void LocalServiceRegistry::unregisterService(const ServiceKey &service_key, const std::shared_ptr<LocalService> &service)
+{
+	std::unique_lock<std::mutex> registry_lock(registry_mutex);
+	auto service_it = services.find(service_key);
+	// only remove the entry if it has not been replaced by another service in the meantime
+	if(service_it != services.end() && (service_it->second.expired() || service_it->second.lock() == service)) {
+		services.erase(service_it);
+	}
+}
+
+} /* namespace SmartDDS */
@@ -0,0 +1,269 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_LOCALSERVICEREGISTRY_H_
+#define RTIDDSSMARTSOFT_LOCALSERVICEREGISTRY_H_
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <shared_mutex>
+#include <condition_variable>
+
+namespace SmartDDS {
+
+/** Interface implemented by the client patterns that are connected to a local (in-process) service.
+ */
+class LocalServiceClient {
+public:
+	virtual ~LocalServiceClient() = default;
+
+	// is called (once) when the local service is shut down (i.e. the server-initiated-disconnect)
+	virtual void onLocalServiceDisconnect() = 0;
+};
+
+/** The threads that execute the local (in-process) deliveries of all the dispatchers of one component.
+ *
+ *  Each component owns one pool (see Component::getLocalDispatcherPool()). A thread is only started if
+ *  all started threads are busy, so a component without local connections does not start any thread
+ *  and the number of threads follows the number of concurrently running deliveries (instead of the
+ *  number of local receivers). By default, the number of threads is not limited, as a handler may
+ *  block on another local service of the same component (e.g. a nested query), which a bounded
+ *  pool could deadlock.
+ */
+class LocalDispatcherPool {
+public:
+	using Task = std::function<void()>;
+
+private:
+	// the state is shared with the threads, which allows destroying the pool from within a task
+	struct PoolState {
+		std::mutex pool_mutex;
+		std::condition_variable pool_cond;
+		std::deque<Task> tasks;
+		size_t idle_threads = 0;
+		bool stopped = false;
+	};
+	std::shared_ptr<PoolState> state;
+	// 0 means unbounded
+	size_t max_threads;
+	// guarded by the pool_mutex
+	std::vector<std::thread> threads;
+
+	static void workerRunnable(std::shared_ptr<PoolState> state);
+
+	// this class is not supposed to be copied
+	LocalDispatcherPool(const LocalDispatcherPool&) = delete;
+	LocalDispatcherPool& operator=(const LocalDispatcherPool&) = delete;
+
+public:
+	// 0 means unbounded
+	LocalDispatcherPool(const size_t &max_threads = 0);
+	virtual ~LocalDispatcherPool();
+
+	/** queues the task for one of the threads
+	 * @return false if the pool is already destroyed (the task is then dropped)
+	 */
+	bool execute(const Task &task);
+
+	// the number of currently started threads
+	size_t getNumberOfThreads();
+};
+
+/** Executes the deliveries of one receiver of a local (in-process) service in their order of posting.
+ *
+ *  The local services never call user code (i.e. handlers and observers) from within the delivering
+ *  thread, but hand the (shared) data over to the dispatcher of the receiving side. This decouples
+ *  slow receivers from the sender and allows the handlers to call back into the patterns (e.g. to
+ *  unsubscribe or disconnect). The deliveries are executed by the threads of the component's
+ *  LocalDispatcherPool, but the deliveries of one dispatcher never run concurrently.
+ */
+class LocalDispatcher {
+public:
+	using Delivery = std::function<void()>;
+
+private:
+	struct PendingDelivery {
+		Delivery deliver;
+		// (optional) is called instead of deliver if the delivery is dropped
+		Delivery discard;
+	};
+	// the state is shared with the pool's task, which allows stopping the dispatcher from within a delivery
+	struct DispatcherState {
+		std::mutex dispatcher_mutex;
+		// is notified after each executed delivery
+		std::condition_variable dispatcher_cond;
+		std::deque<PendingDelivery> deliveries;
+		// true while a task of this dispatcher is queued in (or executed by) the pool
+		bool scheduled = false;
+		bool stopped = false;
+		// the thread of the currently running delivery (if any)
+		std::thread::id running_thread;
+	};
+	std::shared_ptr<DispatcherState> state;
+	// 0 means unbounded, otherwise the oldest pending delivery is dropped
+	size_t max_pending;
+	std::shared_ptr<LocalDispatcherPool> pool;
+
+	static void executeDeliveries(std::shared_ptr<DispatcherState> state);
+	static void discardAll(std::deque<PendingDelivery> &deliveries);
+
+	// this class is not supposed to be copied
+	LocalDispatcher(const LocalDispatcher&) = delete;
+	LocalDispatcher& operator=(const LocalDispatcher&) = delete;
+
+public:
+	LocalDispatcher(const std::shared_ptr<LocalDispatcherPool> &pool, const size_t &max_pending = 0);
+	virtual ~LocalDispatcher();
+
+	void setMaxPending(const size_t &max_pending);
+
+	/** queues the delivery for the dispatcher thread
+	 * @return false if the dispatcher is already stopped (the delivery is then dropped)
+	 */
+	bool post(const Delivery &deliver, const Delivery &discard = nullptr);
+
+	// drops all pending (not yet started) deliveries
+	void clear();
+
+	/** drops all pending deliveries and permanently stops the dispatcher
+	 *
+	 *  Waits for a currently running delivery to complete unless called from within a delivery.
+	 */
+	void stop();
+};
+
+/** The common base of all local (in-process) services.
+ *
+ *  A local service allows client patterns that live in the same process as the
+ *  related server pattern to bypass DDS entirely (see LocalServiceRegistry).
+ */
+class LocalService {
+protected:
+	// shared for the data delivery, unique for the (dis-)connection management
+	mutable std::shared_timed_mutex service_mutex;
+	bool active;
+	std::vector<LocalServiceClient*> clients;
+
+	// executes the server-side handlers (i.e. neither in the client's thread nor under the service_mutex)
+	LocalDispatcher server_dispatcher;
+
+public:
+	LocalService(const std::shared_ptr<LocalDispatcherPool> &pool);
+	virtual ~LocalService() = default;
+
+	bool isActive() const;
+
+	/** attaches the client to this service
+	 * @return false if the service is not active anymore
+	 */
+	bool attach(LocalServiceClient *client);
+	void detach(LocalServiceClient *client);
+
+	// deactivates this service, notifies all attached clients and drops the not yet dispatched requests
+	void deactivate();
+};
+
+/** Process-wide registry of the local services.
+ *
+ *  Each server pattern registers a local service under its unique service name within its
+ *  DDS domain (components in different domains never see each other, neither via DDS nor
+ *  via the registry, even if they use the same component names). A client
+ *  pattern connecting to a service looks up the registry first, and if the service is provided
+ *  by the same process, the client uses a direct in-memory delivery (no DDS serialization and
+ *  no loop-back transport). Otherwise, the client falls back to the regular DDS connection.
+ *  The pattern interfaces and status codes are the same in both cases.
+ */
+class LocalServiceRegistry {
+public:
+	// the DDS domain ID and the service name
+	using ServiceKey = std::pair<int, std::string>;
+
+private:
+	std::mutex registry_mutex;
+	std::map<ServiceKey, std::weak_ptr<LocalService>> services;
+	std::atomic<bool> enabled;
+
+	LocalServiceRegistry();
+
+public:
+	static LocalServiceRegistry& instance();
+
+	/** allows (de-)activating the local short-circuit (e.g. to enforce the DDS transport for testing)
+	 *
+	 *  This only affects subsequent connections, already established connections remain as they are.
+	 */
+	void setEnabled(const bool enabled);
+	bool isEnabled() const;
+
+	void registerService(const ServiceKey &service_key, const std::shared_ptr<LocalService> &service);
+	void unregisterService(const ServiceKey &service_key, const std::shared_ptr<LocalService> &service);
+
+	/** find a local service with the given domain and name and the expected service type
+	 *  @return nullptr if no (matching) local service is registered
+	 */
+	template <class ServiceType>
+	std::shared_ptr<ServiceType> findService(const ServiceKey &service_key)
+	{
+		if(!isEnabled()) {
+			return nullptr;
+		}
+		std::unique_lock<std::mutex> registry_lock(registry_mutex);
+		auto service_it = services.find(service_key);
+		if(service_it != services.end()) {
+			// the cast fails if the server uses different communication objects (which results in the DDS fallback)
+			return std::dynamic_pointer_cast<ServiceType>(service_it->second.lock());
+		}
+		return nullptr;
+	}
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_LOCALSERVICEREGISTRY_H_ */
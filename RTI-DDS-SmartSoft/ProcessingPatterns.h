@@ -10,7 +10,19 @@
 
 #include <smartIProcessingPatterns_T.h>
 
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+
 #include "RTI-DDS-SmartSoft/Task.h"
+#include "RTI-DDS-SmartSoft/CorrelationId.h"
 #include "RTI-DDS-SmartSoft/QueryServerHandler.h"
 
 namespace SmartDDS {
@@ -81,6 +93,349 @@ public:
 	}
 };
 
+/** Decorator for QueryServerHandler to handle the queries within a pool of threads.
+ *
+ *  In contrast to the ThreadQueueQueryHandler (which handles all queries one after another),
+ *  this handler executes up to N queries in parallel, which is useful for CPU-heavy handlers
+ *  (e.g. IK solving or path planning). Each worker thread has its own queue. The incoming queries
+ *  are distributed round-robin and idle workers steal queries from the queues of the busy workers.
+ *
+ *  If per-client ordering is enabled, the queries of each client (i.e. of each query client
+ *  connection) are handled one after another in their order of arrival, while the queries of
+ *  different clients are still handled in parallel. This also holds for clients within the same
+ *  process (see LocalServiceRegistry), as each of their connections has its own connection ID.
+ *
+ *  The number of pending queries (i.e. queries that have not yet been started) is bounded.
+ *  Further queries are rejected with a status code (see submitQuery()), which is passed
+ *  to an optional rejection handler (e.g. to answer with an error answer object). Without
+ *  a rejection handler, rejected queries are answered with a default-constructed answer
+ *  object, so the requesting client is never left waiting for an answer.
+ *
+ *  example usage:
+ *  \code
+ *  auto heavyHandler = std::make_shared<MyHeavyQueryHandler>();
+ *  auto poolHandler = std::make_shared<WorkStealingQueryHandler<R,A>>(component, heavyHandler, 4, 100, true);
+ *  QueryServer queryService<R,A>(component,"heavy_computation", poolHandler);
+ *  \endcode
+ */
+template<class RequestType, class AnswerType>
+class WorkStealingQueryHandler
+:	public Smart::IQueryServerHandler<RequestType,AnswerType>
+{
+public:
+	using IQueryServerHandlerPtr = std::shared_ptr<Smart::IQueryServerHandler<RequestType,AnswerType>>;
+	using QueryServer = Smart::IQueryServerPattern<RequestType,AnswerType>;
+
+	// is called for each rejected query together with the rejection status (see submitQuery())
+	using RejectionHandler = std::function<void(QueryServer &server, const Smart::QueryIdPtr &id, const RequestType &request, const Smart::StatusCode &status)>;
+
+private:
+	struct Query {
+		QueryServer *server;
+		Smart::QueryIdPtr id;
+		RequestType request;
+	};
+	// the queries of one client (only used with per-client ordering)
+	struct Strand {
+		CorrelationKey client_key;
+		std::deque<Query> queries;
+	};
+	// a work item is either a single query or the next query of a strand
+	struct WorkItem {
+		Query query;
+		std::shared_ptr<Strand> strand;
+	};
+	struct WorkerQueue {
+		std::mutex queue_mutex;
+		std::deque<WorkItem> items;
+	};
+
+	class Worker : public SmartDDS::Task {
+	private:
+		WorkStealingQueryHandler *pool;
+		size_t index;
+		virtual int task_execution() override {
+			pool->runWorker(index);
+			return 0;
+		}
+	public:
+		Worker(Smart::IComponent *component, WorkStealingQueryHandler *pool, const size_t &index)
+		:	SmartDDS::Task(component)
+		,	pool(pool)
+		,	index(index)
+		{  }
+	};
+
+	IQueryServerHandlerPtr inner_handler;
+	const size_t max_pending_queries;
+	const bool per_client_ordering;
+
+	std::vector<std::unique_ptr<WorkerQueue>> queues;
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::atomic<size_t> next_queue;
+
+	// the idle workers wait until new work items are pushed (or until the pool is stopped)
+	std::mutex idle_mutex;
+	std::condition_variable idle_cond;
+	std::atomic<size_t> queued_items;
+	std::atomic<bool> running;
+
+	std::atomic<size_t> pending_queries;
+	std::atomic<size_t> rejected_queries;
+
+	std::mutex strands_mutex;
+	std::unordered_map<CorrelationKey, std::shared_ptr<Strand>, CorrelationKeyHash> strands;
+
+	std::mutex rejection_mutex;
+	RejectionHandler rejection_handler;
+
+	void pushItem(const size_t &queue_index, WorkItem &&item)
+	{
+		{
+			std::unique_lock<std::mutex> queue_lock(queues[queue_index]->queue_mutex);
+			queues[queue_index]->items.push_back(std::move(item));
+		}
+		{
+			std::unique_lock<std::mutex> idle_lock(idle_mutex);
+			queued_items++;
+		}
+		idle_cond.notify_one();
+	}
+
+	// the owner takes the oldest item of its own queue, whereas thieves take the newest items of other queues
+	bool popItem(const size_t &worker_index, WorkItem &item)
+	{
+		for(size_t offset = 0; offset < queues.size(); ++offset) {
+			auto &queue = *queues[(worker_index + offset) % queues.size()];
+			std::unique_lock<std::mutex> queue_lock(queue.queue_mutex);
+			if(!queue.items.empty()) {
+				if(offset == 0) {
+					item = std::move(queue.items.front());
+					queue.items.pop_front();
+				} else {
+					item = std::move(queue.items.back());
+					queue.items.pop_back();
+				}
+				queued_items--;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void runWorker(const size_t &worker_index)
+	{
+		WorkItem item;
+		while(running) {
+			if(popItem(worker_index, item)) {
+				executeItem(worker_index, item);
+				item = WorkItem();
+			} else {
+				std::unique_lock<std::mutex> idle_lock(idle_mutex);
+				idle_cond.wait(idle_lock, [this]() { return queued_items > 0 || !running; });
+			}
+		}
+	}
+
+	void executeItem(const size_t &worker_index, WorkItem &item)
+	{
+		if(!item.strand) {
+			pending_queries--;
+			inner_handler->handleQuery(*item.query.server, item.query.id, item.query.request);
+			return;
+		}
+
+		Query query;
+		{
+			std::unique_lock<std::mutex> strands_lock(strands_mutex);
+			query = std::move(item.strand->queries.front());
+			item.strand->queries.pop_front();
+		}
+		pending_queries--;
+		inner_handler->handleQuery(*query.server, query.id, query.request);
+
+		// the strand is scheduled again (i.e. only one query of a client is handled at a time) until it is drained
+		std::unique_lock<std::mutex> strands_lock(strands_mutex);
+		if(item.strand->queries.empty()) {
+			strands.erase(item.strand->client_key);
+		} else {
+			strands_lock.unlock();
+			pushItem(worker_index, WorkItem{Query(), std::move(item.strand)});
+		}
+	}
+
+	static CorrelationKey getClientKey(const Smart::QueryIdPtr &id)
+	{
+		auto correlation_id = std::dynamic_pointer_cast<CorrelationId>(id);
+		if(correlation_id) {
+			return correlation_id->getConnectionKey();
+		}
+		return CorrelationKey();
+	}
+
+public:
+	/** Create a new QueryServerHandler Decorator with a pool of worker threads.
+	 *
+	 *  The worker threads are started/stopped automatically.
+	 *
+	 *  @param component            the pointer to the surrounding component
+	 *  @param inner_handler_ptr    which will be called within the worker threads
+	 *  @param number_of_workers    the number of worker threads (zero uses the number of hardware threads)
+	 *  @param max_pending_queries  the maximal number of queries that wait to be handled
+	 *  @param per_client_ordering  if true, the queries of each client are handled one after another
+	 */
+	WorkStealingQueryHandler(
+			Smart::IComponent *component,
+			IQueryServerHandlerPtr inner_handler_ptr,
+			const size_t &number_of_workers = 0,
+			const size_t &max_pending_queries = 1024,
+			const bool &per_client_ordering = false)
+	:	inner_handler(inner_handler_ptr)
+	,	max_pending_queries(max_pending_queries)
+	,	per_client_ordering(per_client_ordering)
+	,	next_queue(0)
+	,	queued_items(0)
+	,	running(false)
+	,	pending_queries(0)
+	,	rejected_queries(0)
+	{
+		size_t worker_count = number_of_workers;
+		if(worker_count == 0) {
+			worker_count = std::max(1u, std::thread::hardware_concurrency());
+		}
+		for(size_t i=0; i<worker_count; ++i) {
+			queues.emplace_back(new WorkerQueue());
+			workers.emplace_back(new Worker(component, this, i));
+		}
+		this->start();
+	}
+
+	virtual ~WorkStealingQueryHandler()
+	{
+		this->stop();
+	}
+
+	/// starts the worker threads (if not yet started)
+	int start()
+	{
+		if(running.exchange(true) == true) {
+			return 0;
+		}
+		int result = 0;
+		for(auto &worker: workers) {
+			if(worker->start() != 0) {
+				result = -1;
+			}
+		}
+		return result;
+	}
+
+	/** stops the worker threads (the currently handled queries are completed, whereas the
+	 *  queries which have not yet been started are dropped)
+	 */
+	int stop()
+	{
+		{
+			std::unique_lock<std::mutex> idle_lock(idle_mutex);
+			running = false;
+		}
+		idle_cond.notify_all();
+		int result = 0;
+		for(auto &worker: workers) {
+			if(worker->stop() != 0) {
+				result = -1;
+			}
+		}
+
+		for(auto &queue: queues) {
+			std::unique_lock<std::mutex> queue_lock(queue->queue_mutex);
+			queued_items -= queue->items.size();
+			queue->items.clear();
+		}
+		std::unique_lock<std::mutex> strands_lock(strands_mutex);
+		strands.clear();
+		pending_queries = 0;
+		return result;
+	}
+
+	/** sets the handler that is called for each rejected query (it is called within the thread of the query server),
+	 *  the handler is responsible for answering the rejected query (e.g. with an error answer object)
+	 */
+	void setRejectionHandler(const RejectionHandler &handler)
+	{
+		std::unique_lock<std::mutex> rejection_lock(rejection_mutex);
+		rejection_handler = handler;
+	}
+
+	/** Enqueue a query to be handled by the worker threads.
+	 *
+	 *  @return status code
+	 *    - SMART_OK            : the query has been enqueued
+	 *    - SMART_CANCELLED     : the query has been rejected as the maximal number of pending queries is reached
+	 *    - SMART_NOTACTIVATED  : the query has been rejected as the worker threads are stopped
+	 */
+	Smart::StatusCode submitQuery(QueryServer &server, const Smart::QueryIdPtr &id, const RequestType &request)
+	{
+		if(!running) {
+			return Smart::StatusCode::SMART_NOTACTIVATED;
+		}
+		if(pending_queries++ >= max_pending_queries) {
+			pending_queries--;
+			return Smart::StatusCode::SMART_CANCELLED;
+		}
+
+		auto queue_index = next_queue++ % queues.size();
+		if(!per_client_ordering) {
+			pushItem(queue_index, WorkItem{Query{&server, id, request}, nullptr});
+			return Smart::StatusCode::SMART_OK;
+		}
+
+		auto client_key = getClientKey(id);
+		std::unique_lock<std::mutex> strands_lock(strands_mutex);
+		auto &strand = strands[client_key];
+		if(strand) {
+			// the strand is already scheduled and takes this query after the preceding ones
+			strand->queries.push_back(Query{&server, id, request});
+			return Smart::StatusCode::SMART_OK;
+		}
+		strand = std::make_shared<Strand>();
+		strand->client_key = client_key;
+		strand->queries.push_back(Query{&server, id, request});
+		auto scheduled_strand = strand;
+		strands_lock.unlock();
+
+		pushItem(queue_index, WorkItem{Query(), std::move(scheduled_strand)});
+		return Smart::StatusCode::SMART_OK;
+	}
+
+	virtual void handleQuery(QueryServer &server, const Smart::QueryIdPtr &id, const RequestType &request) override
+	{
+		auto status = this->submitQuery(server, id, request);
+		if(status != Smart::StatusCode::SMART_OK) {
+			rejected_queries++;
+			std::unique_lock<std::mutex> rejection_lock(rejection_mutex);
+			auto handler = rejection_handler;
+			rejection_lock.unlock();
+			if(handler) {
+				handler(server, id, request, status);
+			} else {
+				// the query server keeps each query until it is answered, so a rejected query must be answered as well
+				server.answer(id, AnswerType());
+			}
+		}
+	}
+
+	/// returns the number of queries that are currently waiting to be handled
+	size_t getPendingQueries() const {
+		return pending_queries;
+	}
+
+	/// returns the number of rejected queries since the creation of this handler
+	size_t getRejectedQueries() const {
+		return rejected_queries;
+	}
+};
+
 } /* namespace SmartDDS */
 
 #endif /* RTIDDSSMARTSOFT_PROCESSINGPATTERNS_H_ */
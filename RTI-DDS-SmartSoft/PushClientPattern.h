@@ -44,43 +44,177 @@
 #define RTIDDSSMARTSOFT_PUSHCLIENTPATTERN_H_
 
 #include "RTI-DDS-SmartSoft/Component.h"
+#include "RTI-DDS-SmartSoft/AsyncConnector.h"
 #include "RTI-DDS-SmartSoft/PushPatternQoS.h"
 #include "RTI-DDS-SmartSoft/DDSReaderConnector.h"
+#include "RTI-DDS-SmartSoft/DDSTypeTraits.h"
+#include "RTI-DDS-SmartSoft/DDSWaitSetPool.h"
+#include "RTI-DDS-SmartSoft/LocalPushService.h"
+#include "RTI-DDS-SmartSoft/TimeIndexedHistory.h"
 
 #include <smartIPushClientPattern_T.h>
 
 #include <mutex>
+#include <deque>
+#include <vector>
+#include <future>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <type_traits>
 
 namespace SmartDDS {
 
+/** An observer of the updates received by a PushClientPattern (together with their source timestamps).
+ *
+ *  The observers are called from within the receiving thread (i.e. the DDS listener thread or the
+ *  client's local dispatcher, see LocalDispatcher), so the implementations
+ *  should return quickly (e.g. by only queuing the shared update, see ApproximateTimeSynchronizer).
+ */
+template <class DataType>
+class PushUpdateObserver {
+public:
+	virtual ~PushUpdateObserver() = default;
+	virtual void on_push_update(const std::shared_ptr<const DataType> &data, const std::chrono::system_clock::time_point &timestamp) = 0;
+};
+
 template <class DataType>
 class PushClientPattern
 :	public Smart::IPushClientPattern<DataType>
-,	public DynamicDataReaderListener
+,	public DDSReaderListener<typename DDSTypeTraits<DataType>::SampleType>
+,	public LocalPushClient<DataType>
 {
 private:
+	using TypeTraits = DDSTypeTraits<DataType>;
+	using SampleType = typename TypeTraits::SampleType;
+
 	Component *component;
 
 	std::recursive_mutex connection_mutex;
+	// the background connect of connectAsync(...), which is completed before disconnecting
+	AsyncConnector async_connector;
 
-	dds::topic::Topic<dds::core::xtypes::DynamicData> dds_parent_topic;
+	DDSTopic<SampleType> dds_parent_topic;
 
 	// this helper allows checking if a remote end-point actually responds during a connection phase (see connect(...) method)
-	DDSReaderConnector dds_reader_connector;
+	DDSReaderConnector<SampleType> dds_reader_connector;
 
-	DynamicDataFilteredTopic dds_subscription_topic;
-	DynamicDataReader dds_subscription_reader;
+	DDSFilteredTopic<SampleType> dds_subscription_topic;
+	DDSReader<SampleType> dds_subscription_reader;
 
-	dds::sub::cond::ReadCondition new_data_guard;
 	dds::sub::status::DataState default_read_state;
 
+	// the latest already converted value, which is shared between the DDS and the in-process delivery paths;
+	// it is exchanged using the atomic shared_ptr functions, so getUpdate(...) neither calls DDS nor converts again
+	std::shared_ptr<const DataType> latest_value;
+	// this guard is triggered on each new value until the latest value has been read
+	dds::core::cond::GuardCondition new_data_guard;
+
 	// these three guard conditions allow managing the pattern's internal states (i.e. connected, subscribed, blocking)
 	// please note, only if all three guards have the "false" value, only then a blocking getUpdateWait is allowed
 	dds::core::cond::GuardCondition disconnected_guard;
 	dds::core::cond::GuardCondition unsubscribed_guard;
 	dds::core::cond::GuardCondition nonblocking_guard;
 
-    void on_liveliness_changed(dds::sub::DataReader<dds::core::xtypes::DynamicData>&,
+	// the in-process delivery path is used if the server lives in the same process (see LocalServiceRegistry)
+	std::shared_ptr<LocalPushService<DataType>> local_service;
+
+	// the number of not yet taken updates that are kept for getUpdates(...)
+	unsigned int history_depth;
+	// the not yet taken updates of the in-process delivery path (the DDS path keeps them within the reader)
+	std::mutex local_history_mutex;
+	std::deque<std::shared_ptr<const DataType>> local_history;
+	// the in-process updates are handed over to this client's own dispatcher (at most history_depth are pending),
+	// so neither the server's put() nor the service_mutex are held while the input handlers and observers are called
+	LocalDispatcher local_dispatcher;
+
+	// the WaitSets of getUpdateWait(...) with the above four guards attached
+	DDSWaitSetPool wait_sets;
+
+	void discard_pending_updates()
+	{
+		{
+			std::unique_lock<std::mutex> history_lock(local_history_mutex);
+			local_history.clear();
+		}
+		local_dispatcher.clear();
+		if(!dds_subscription_reader.is_nil()) {
+			try {
+				// the returned loan is released right away
+				dds_subscription_reader.take();
+			} catch (dds::core::Error &err) {
+				std::cerr << err.what() << std::endl;
+			}
+		}
+	}
+
+	// the optional time-indexed history of the received values (see setTimeIndexedHistory)
+	std::shared_ptr<TimeIndexedHistory<DataType>> time_history;
+
+	std::mutex update_observers_mutex;
+	std::vector<PushUpdateObserver<DataType>*> update_observers;
+
+	void store_latest_value(const std::shared_ptr<const DataType> &data, const std::chrono::system_clock::time_point &timestamp)
+	{
+		if(auto history = std::atomic_load(&time_history)) {
+			history->push(timestamp, data);
+		}
+		std::atomic_store(&latest_value, data);
+		new_data_guard.trigger_value(true);
+	}
+	// calls the user code (i.e. the input handlers and the update observers)
+	void notify_update(const std::shared_ptr<const DataType> &data, const std::chrono::system_clock::time_point &timestamp)
+	{
+		this->notify_input(*data);
+		std::unique_lock<std::mutex> observers_lock(update_observers_mutex);
+		for(auto observer: update_observers) {
+			observer->on_push_update(data, timestamp);
+		}
+	}
+	void publish_latest_value(const std::shared_ptr<const DataType> &data, const std::chrono::system_clock::time_point &timestamp)
+	{
+		store_latest_value(data, timestamp);
+		notify_update(data, timestamp);
+	}
+	void reset_latest_value()
+	{
+		std::atomic_store(&latest_value, std::shared_ptr<const DataType>());
+		new_data_guard.trigger_value(false);
+		if(auto history = std::atomic_load(&time_history)) {
+			history->clear();
+		}
+	}
+
+	virtual void onLocalUpdate(const std::shared_ptr<const DataType> &data) override
+	{
+		if(this->is_shutting_down() || disconnected_guard.trigger_value())
+			return;
+
+		{
+			std::unique_lock<std::mutex> history_lock(local_history_mutex);
+			local_history.push_back(data);
+			while(local_history.size() > history_depth) {
+				local_history.pop_front();
+			}
+		}
+		// the latest value is stored right away, so the reception time is also the publication time
+		auto timestamp = std::chrono::system_clock::now();
+		store_latest_value(data, timestamp);
+
+		// the input handlers and observers are called from within this client's dispatcher
+		local_dispatcher.post([this, data, timestamp]() {
+			// updates that were already queued while the subscription has been paused are ignored
+			if(this->is_shutting_down() || disconnected_guard.trigger_value() || unsubscribed_guard.trigger_value())
+				return;
+			notify_update(data, timestamp);
+		});
+	}
+	virtual void onLocalServiceDisconnect() override
+	{
+		disconnected_guard.trigger_value(true);
+	}
+
+    void on_liveliness_changed(DDSReader<SampleType>&,
        const dds::core::status::LivelinessChangedStatus &status)
     {
     	if(status.alive_count() == 0) {
@@ -89,21 +223,77 @@ private:
     		disconnected_guard.trigger_value(false);
     	}
     }
-    void on_data_available(dds::sub::DataReader<dds::core::xtypes::DynamicData> &reader)
+    // zero-copy samples are shared with the writer, which might reuse them while we are still reading
+    bool is_consistent(DDSReader<SampleType> &reader, const dds::sub::LoanedSample<SampleType> &sample, std::false_type) const
     {
-		if(this->is_shutting_down() || disconnected_guard.trigger_value())
+    	return true;
+    }
+    bool is_consistent(DDSReader<SampleType> &reader, const dds::sub::LoanedSample<SampleType> &sample, std::true_type) const
+    {
+    	return reader->is_data_consistent(sample);
+    }
+
+    static std::chrono::system_clock::time_point to_time_point(const dds::core::Time &time)
+    {
+    	auto since_epoch = std::chrono::seconds(time.sec()) + std::chrono::nanoseconds(time.nanosec());
+    	return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(since_epoch));
+    }
+
+    void on_data_available(DDSReader<SampleType> &reader)
+    {
+		// samples that were already in transit while the subscription has been paused are ignored
+		if(this->is_shutting_down() || disconnected_guard.trigger_value() || unsubscribed_guard.trigger_value())
 			return;
 
-		auto samples = reader.read();
+		// only the not-yet read samples are converted (exactly once)
+		auto samples = reader.select().state(default_read_state).read();
 		for(auto sample: samples) {
 			if(sample.info().valid()) {
-				DataType input;
-				convert(sample.data(), input);
-				this->notify_input(input);
+				auto input = std::make_shared<DataType>();
+				TypeTraits::fromSample(sample.data(), *input);
+				if(!is_consistent(reader, sample, std::integral_constant<bool, TypeTraits::zero_copy>()))
+					continue;
+				publish_latest_value(input, to_time_point(sample.info().source_timestamp()));
 			}
 		}
     }
 
+    // the common implementation of the prescale-based and the rate-based subscription
+    Smart::StatusCode subscribe_filtered(const unsigned int &prescale, const std::chrono::nanoseconds &minimum_separation)
+    {
+    	std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
+
+    	if(disconnected_guard.trigger_value() == true)
+    	    return Smart::StatusCode::SMART_DISCONNECTED;
+
+    	// old values from a previous subscription are not returned
+    	reset_latest_value();
+    	discard_pending_updates();
+
+    	if(local_service) {
+    		if(!local_service->subscribe(this, prescale,
+    				std::chrono::duration_cast<std::chrono::steady_clock::duration>(minimum_separation))) {
+    			return Smart::StatusCode::SMART_DISCONNECTED;
+    		}
+    		unsubscribed_guard.trigger_value(false);
+    		return Smart::StatusCode::SMART_OK;
+    	}
+
+    	try {
+			// the prescale (and optional time-based) filter of the already connected reader is adjusted
+			// in place, so neither the filtered topic nor the reader need to be recreated
+			auto filter_parameters = CorrelationIdFilterBase::createSubscriptionParameters(prescale, minimum_separation);
+			dds_subscription_topic.filter_parameters(filter_parameters.begin(), filter_parameters.end());
+			unsubscribed_guard.trigger_value(false);
+			return Smart::StatusCode::SMART_OK;
+    	} catch (dds::core::Error &err) {
+    		std::cerr << err.what() << std::endl;
+    		return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
+    	}
+
+    	return Smart::StatusCode::SMART_ERROR;
+    }
+
 public:
     /** Constructor (not wired with service provider and not exposed as port).
      *  connect() / disconnect() can always be used to change
@@ -119,8 +309,10 @@ public:
 	,	dds_reader_connector(component, PushPatternQoS::getTopicQoS())
 	,	dds_subscription_topic(nullptr)
 	,	dds_subscription_reader(nullptr)
-	,	new_data_guard(nullptr)
 	,	default_read_state()
+	,	history_depth(1)
+	,	local_dispatcher(component->getLocalDispatcherPool(), 1)
+	,	wait_sets({new_data_guard, disconnected_guard, unsubscribed_guard, nonblocking_guard})
 	{
 		// by default, the client initializes in the disconnected state
 		disconnected_guard.trigger_value(true);
@@ -148,8 +340,10 @@ public:
 	,	dds_reader_connector(component, PushPatternQoS::getTopicQoS())
 	,	dds_subscription_topic(nullptr)
 	,	dds_subscription_reader(nullptr)
-	,	new_data_guard(nullptr)
 	,	default_read_state()
+	,	history_depth(1)
+	,	local_dispatcher(component->getLocalDispatcherPool(), 1)
+	,	wait_sets({new_data_guard, disconnected_guard, unsubscribed_guard, nonblocking_guard})
 	{
 		// by default, the client initializes in the disconnected state
 		disconnected_guard.trigger_value(true);
@@ -166,6 +360,8 @@ public:
      */
     virtual ~PushClientPattern() {
     	this->disconnect();
+    	// waits for a currently running local delivery
+    	local_dispatcher.stop();
     }
 
     /** Connect this service requestor to the denoted service provider. An
@@ -193,6 +389,9 @@ public:
      */
     virtual Smart::StatusCode connect(const std::string& server, const std::string& service) override
     {
+    	// a pending connectAsync(...) is completed first (it holds the connection mutex while connecting)
+    	async_connector.wait();
+
     	std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
 
     	// we by default disconnect the previous connection
@@ -205,14 +404,26 @@ public:
 			// the topic-name is constructed from the component-instance-name and a server-port-name
 			std::string topicName = server+"::"+service;
 
-			// the dynamic type is determined from an externally implemented template method dds_type()
-			auto dynamic_type = dds_type<DataType>();
-			dds_parent_topic = component->DDS().findOrCreateTopic(topicName, dynamic_type);
+			// a server within the same process is connected directly (bypassing DDS)
+			local_service = LocalServiceRegistry::instance().findService<LocalPushService<DataType>>(
+					LocalServiceRegistry::ServiceKey(component->DDS().getDomainId(), "PushService::"+topicName));
+			if(local_service && local_service->attach(this)) {
+				disconnected_guard.trigger_value(false);
+				return Smart::StatusCode::SMART_OK;
+			}
+			local_service = nullptr;
+
+			// the topic type is determined by the DDSTypeTraits (either DynamicData or an IDL-generated type)
+			dds_parent_topic = TypeTraits::findOrCreateTopic(component->DDS(), topicName);
 
-			ConnectionId empty_id;
-			dds_subscription_topic = component->DDS().findOrCreateClientFilteredTopic(dds_parent_topic, empty_id);
+			// each client uses its own filtered topic, which initially pauses the subscription
+			// (the filter parameters are later adjusted by the subscribe and unsubscribe methods)
+			auto subscriber_id = ConnectionId::createUnique();
+			auto filter_parameters = CorrelationIdFilterBase::createSubscriptionParameters(0);
+			dds_subscription_topic = component->DDS().findOrCreateClientFilteredTopic(dds_parent_topic, subscriber_id, filter_parameters);
 
-			auto timeout = std::chrono::seconds(1);
+			dds_reader_connector.setQosProfile(DDSQosProfiles::findReaderProfile("PushPattern", component->getName(), server, service));
+			auto timeout = component->getConnectionTimeout();
 			auto connection_status = dds_reader_connector.reconnect(dds_subscription_reader, dds_subscription_topic, timeout, this);
 			if(connection_status != Smart::StatusCode::SMART_OK) {
 				this->disconnect();
@@ -231,6 +442,27 @@ public:
     	return Smart::StatusCode::SMART_ERROR;
     }
 
+    /** Asynchronously connect this service requestor to the denoted service provider.
+     *
+     *  This method returns immediately and performs the connect(server, service) call in the
+     *  background. This allows all client ports of a component to establish their connections
+     *  in parallel (instead of one after another) and to collect the results afterwards.
+     *  The maximal waiting time of each connection attempt is configured by the component
+     *  (see Component::setConnectionTimeout). A pending background connect is completed
+     *  before disconnect() proceeds (which also applies to the destructor).
+     *
+     * @param server     name of the server (i.e. the component-name to connect to)
+     * @param service    name of the service (i.e. the port-name of the component to connect to)
+     *
+     * @return a future providing the status code of the connect(server, service) call
+     */
+    std::future<Smart::StatusCode> connectAsync(const std::string& server, const std::string& service)
+    {
+    	return async_connector.start([this, server, service]() {
+    		return this->connect(server, service);
+    	});
+    }
+
     /** Disconnect the service requestor from the service provider.
      *
      *  It is no problem to change the connection to a service provider at any
@@ -250,11 +482,23 @@ public:
 		// first thing is to change the disconnected guard to true so no blocking calls will be used from here on
 		disconnected_guard.trigger_value(true);
 
+		// a pending connectAsync(...) is completed first (the connection is then closed below)
+		async_connector.wait();
+
 		std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
 
 		// by default we also unsubscribe
 		this->unsubscribe();
 
+		if(local_service) {
+			// the unsubscribe() above returns early as the disconnected guard is already set
+			local_service->unsubscribe(this);
+			local_service->detach(this);
+			local_service = nullptr;
+		}
+		reset_latest_value();
+		discard_pending_updates();
+
 		dds_reader_connector.reset(dds_subscription_reader);
 		component->DDS().resetFilteredTopic(dds_subscription_topic);
 		component->DDS().resetTopic(dds_parent_topic);
@@ -301,42 +545,33 @@ public:
      */
     virtual Smart::StatusCode subscribe(const unsigned int &prescale = 1) override
     {
-    	std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
-
-    	if(disconnected_guard.trigger_value() == true)
-    	    return Smart::StatusCode::SMART_DISCONNECTED;
-
     	if(prescale < 1) {
     		return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
     	}
+    	return subscribe_filtered(prescale, std::chrono::nanoseconds::zero());
+    }
 
-    	try {
-			if(!dds_subscription_reader.is_nil()) {
-				// we temporarily deactivate the connection listener as we will shortly reconnect the reader
-				dds_subscription_reader.listener(NULL, dds::core::status::StatusMask::none());
-			}
-
-			// create prescale filter using the ID of the pre-connected dds_subscription_reader
-			ConnectionId subscriber_id(dds_subscription_reader);
-			dds_subscription_topic = component->DDS().findOrCreateClientFilteredTopic(dds_parent_topic, subscriber_id, std::to_string(prescale));
-
-			auto timeout = std::chrono::seconds(1);
-			auto connection_status = dds_reader_connector.reconnect(dds_subscription_reader, dds_subscription_topic, timeout, this);
-			if(connection_status != Smart::StatusCode::SMART_OK) {
-				this->unsubscribe();
-				return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
-			} else {
-				// re-attach the read condition to the new reader
-				new_data_guard = dds::sub::cond::ReadCondition(dds_subscription_reader, default_read_state);
-				unsubscribed_guard.trigger_value(false);
-			}
-			return connection_status;
-    	} catch (dds::core::Error &err) {
-    		std::cerr << err.what() << std::endl;
+    /** Subscribe at the server to get updates with at most the given rate. In contrast to
+     *  the prescale factor, the update rate is independent of the actual rate of the server.
+     *  Updates exceeding this rate are already filtered out at the server side (i.e. they are
+     *  not transmitted at all), only the next update after the minimal period is passed on.
+     *
+     *  @param max_rate  the maximal update rate in Hz (must be greater than 0)
+     *
+     *  @return status code
+     *    - SMART_OK                  : everything is ok and client is subscribed
+     *    - SMART_DISCONNECTED        : client is not connected to a server and can therefore
+     *                                  not subscribe for updates, not subscribed
+     *    - SMART_ERROR_COMMUNICATION : communication problems, not subscribed
+     *    - SMART_ERROR               : something went wrong, not subscribed
+     */
+    Smart::StatusCode subscribeMaxRate(const double &max_rate)
+    {
+    	if(max_rate <= 0.0) {
     		return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
     	}
-
-    	return Smart::StatusCode::SMART_ERROR;
+    	auto minimum_separation = std::chrono::nanoseconds(static_cast<int64_t>(1.0e9 / max_rate));
+    	return subscribe_filtered(1, minimum_separation);
     }
 
     /** Unsubscribe to get no more updates. All blocking calls are aborted with the appropriate
@@ -360,17 +595,18 @@ public:
 
 		unsubscribed_guard.trigger_value(true);
 
-		try {
-			new_data_guard = nullptr;
+		reset_latest_value();
+		discard_pending_updates();
 
-			if(!dds_subscription_reader.is_nil()) {
-				dds_subscription_reader.listener(NULL, dds::core::status::StatusMask::none());
-			}
+		if(local_service) {
+			local_service->unsubscribe(this);
+			return Smart::StatusCode::SMART_OK;
+		}
 
-			ConnectionId empty_id;
-			dds_subscription_topic = component->DDS().findOrCreateClientFilteredTopic(dds_parent_topic, empty_id);
-			auto timeout = std::chrono::seconds(1);
-			auto connection_status = dds_reader_connector.reconnect(dds_subscription_reader, dds_subscription_topic, timeout, this);
+		try {
+			// pause the subscription (the reader remains connected)
+			auto filter_parameters = CorrelationIdFilterBase::createSubscriptionParameters(0);
+			dds_subscription_topic.filter_parameters(filter_parameters.begin(), filter_parameters.end());
 		} catch (dds::core::Error &err) {
 			std::cerr << err.what() << std::endl;
 			return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
@@ -403,33 +639,227 @@ public:
      */
     virtual Smart::StatusCode getUpdate(DataType& d) override
     {
-    	std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
+    	// this method intentionally does not lock the connection mutex, the latest value is
+    	// already converted in on_data_available(...) and is taken from an atomic snapshot
+    	if(disconnected_guard.trigger_value() == true)
+    		return Smart::StatusCode::SMART_DISCONNECTED;
+    	if(unsubscribed_guard.trigger_value() == true)
+    		return Smart::StatusCode::SMART_UNSUBSCRIBED;
+
+    	// the guard is reset before taking the snapshot: a value that is stored in the meantime
+    	// re-triggers the guard afterwards (at worst this wakes up a waiting call for an already returned value)
+    	if(new_data_guard.trigger_value() == true)
+    		new_data_guard.trigger_value(false);
+
+    	auto latest = std::atomic_load(&latest_value);
+    	if(!latest)
+    		return Smart::StatusCode::SMART_NODATA;
+
+    	// copy the latest value into the provided communication object reference
+    	d = *latest;
+    	return Smart::StatusCode::SMART_OK;
+    }
+
+    /** Non-blocking call to take all updates that have been received since the last call
+     *  of this method (up to the configured history depth, see setHistoryDepth).
+     *
+     *  In contrast to getUpdate(...), which only provides the latest value, this method allows
+     *  consumers such as integrators to process every update even if they run slower than
+     *  the server. The pending samples are taken from the reader in a single call and are
+     *  converted in one pass. The returned updates are ordered by their source timestamps
+     *  (oldest first) and are not returned again by subsequent calls.
+     *
+     * @param updates      is cleared and then filled with the pending updates
+     * @param max_updates  the maximal number of returned updates (zero returns all pending updates),
+     *                     the remaining updates are returned with the next call
+     *
+     * @return status code
+     *   - SMART_OK                  : at least one update is returned
+     *   - SMART_NODATA              : no update has been received since the last call
+     *   - SMART_UNSUBSCRIBED        : the client is not subscribed
+     *   - SMART_DISCONNECTED        : the client is not connected to a server
+     *   - SMART_ERROR_COMMUNICATION : the updates could not be taken from the reader
+     */
+    Smart::StatusCode getUpdates(std::vector<DataType> &updates, const size_t &max_updates = 0)
+    {
+    	updates.clear();
 
     	if(disconnected_guard.trigger_value() == true)
     		return Smart::StatusCode::SMART_DISCONNECTED;
     	if(unsubscribed_guard.trigger_value() == true)
     		return Smart::StatusCode::SMART_UNSUBSCRIBED;
 
-    	try {
-        	// read the current samples (data will not be consumed)
-			auto samples = dds_subscription_reader.read();
-			if(samples.length() == 0)
-				return Smart::StatusCode::SMART_NODATA;
-
-			for(const auto& sample: samples) {
-				if(sample.info().valid()) {
-					// convert and copy the DDS sample into the provided communication object reference
-					// we take only the first valid sample as we can assume there only is one sample
-					convert(sample.data(), d);
-					return Smart::StatusCode::SMART_OK;
-				}
-			}
-    	} catch(dds::core::Error &error) {
-    		std::cerr << error.what() << std::endl;
-    		return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
+    	std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
+
+    	if(local_service) {
+    		// the in-process updates are already converted and are kept in the order of publication
+    		std::unique_lock<std::mutex> history_lock(local_history_mutex);
+    		auto count = local_history.size();
+    		if(max_updates > 0 && max_updates < count)
+    			count = max_updates;
+    		updates.reserve(count);
+    		for(size_t i=0; i<count; ++i) {
+    			updates.push_back(*local_history.front());
+    			local_history.pop_front();
+    		}
+    	} else {
+    		try {
+    			// a single (loaned) take returns all pending samples, the loan is returned at the end of this scope
+    			auto selector = dds_subscription_reader.select();
+    			if(max_updates > 0)
+    				selector.max_samples(static_cast<uint32_t>(max_updates));
+    			auto samples = selector.take();
+
+    			// the samples are sorted by an index, so each sample is converted exactly once (and directly into place)
+    			std::vector<const dds::sub::LoanedSample<SampleType>*> valid_samples;
+    			valid_samples.reserve(samples.length());
+    			for(const auto &sample: samples) {
+    				if(sample.info().valid())
+    					valid_samples.push_back(&sample);
+    			}
+    			std::stable_sort(valid_samples.begin(), valid_samples.end(),
+    					[](const dds::sub::LoanedSample<SampleType> *lhs, const dds::sub::LoanedSample<SampleType> *rhs) {
+    				return lhs->info().source_timestamp() < rhs->info().source_timestamp();
+    			});
+
+    			updates.resize(valid_samples.size());
+    			size_t count = 0;
+    			for(auto sample: valid_samples) {
+    				TypeTraits::fromSample(sample->data(), updates[count]);
+    				if(is_consistent(dds_subscription_reader, *sample, std::integral_constant<bool, TypeTraits::zero_copy>()))
+    					++count;
+    			}
+    			updates.resize(count);
+    		} catch (dds::core::Error &err) {
+    			std::cerr << err.what() << std::endl;
+    			return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
+    		}
     	}
-    	// something unexpected went wrong
-    	return Smart::StatusCode::SMART_ERROR;
+
+    	if(updates.empty())
+    		return Smart::StatusCode::SMART_NODATA;
+    	return Smart::StatusCode::SMART_OK;
+    }
+
+    /** Configures how many not yet taken updates are kept for getUpdates(...).
+     *
+     *  The default depth of one only keeps the latest update. The new depth takes effect
+     *  with the next connect(...) call.
+     *
+     *  @param depth  the number of kept updates (must be greater than 0)
+     *
+     *  @return status code
+     *   - SMART_OK                  : the new depth is set
+     *   - SMART_ERROR               : the depth is zero
+     */
+    Smart::StatusCode setHistoryDepth(const unsigned int &depth)
+    {
+    	if(depth < 1) {
+    		return Smart::StatusCode::SMART_ERROR;
+    	}
+    	std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
+    	{
+    		std::unique_lock<std::mutex> history_lock(local_history_mutex);
+    		history_depth = depth;
+    	}
+    	local_dispatcher.setMaxPending(depth);
+    	dds_reader_connector.setHistoryDepth(static_cast<int32_t>(depth));
+    	return Smart::StatusCode::SMART_OK;
+    }
+
+    /** Attaches an observer that is notified about each received update (see PushUpdateObserver).
+     *
+     *  In contrast to the input handlers, the observers get the shared update together with its source timestamp.
+     */
+    void attachUpdateObserver(PushUpdateObserver<DataType> *observer)
+    {
+    	std::unique_lock<std::mutex> observers_lock(update_observers_mutex);
+    	update_observers.push_back(observer);
+    }
+
+    /** Detaches an observer (once this method returns, the observer is not called anymore).
+     */
+    void detachUpdateObserver(PushUpdateObserver<DataType> *observer)
+    {
+    	std::unique_lock<std::mutex> observers_lock(update_observers_mutex);
+    	update_observers.erase(std::remove(update_observers.begin(), update_observers.end(), observer), update_observers.end());
+    }
+
+    using TimePoint = typename TimeIndexedHistory<DataType>::TimePoint;
+    using Interpolator = typename TimeIndexedHistory<DataType>::Interpolator;
+
+    /** Keeps the given number of the latest updates indexed by their source timestamps,
+     *  so that getUpdateAt(...) and getUpdatesBetween(...) can be used (e.g. for sensor fusion).
+     *
+     *  The kept updates are shared with getUpdate(...) (i.e. they are not copied again) and
+     *  are discarded on each subscribe, unsubscribe and disconnect.
+     *
+     *  @param capacity      the number of kept updates (zero disables the time-indexed history)
+     *  @param interpolator  an optional functor that computes the value between two updates
+     *                       (without it, getUpdateAt returns the update preceding the requested time)
+     */
+    void setTimeIndexedHistory(const size_t &capacity, const Interpolator &interpolator = nullptr)
+    {
+    	std::shared_ptr<TimeIndexedHistory<DataType>> history;
+    	if(capacity > 0) {
+    		history = std::make_shared<TimeIndexedHistory<DataType>>(capacity, interpolator);
+    	}
+    	std::atomic_store(&time_history, history);
+    }
+
+    /** Non-blocking call to return the value at the given (source) time.
+     *
+     *  If the given time lies between two kept updates, then the interpolated value is
+     *  returned (see setTimeIndexedHistory), otherwise the latest update before this time.
+     *
+     *  @param time  the requested source time
+     *  @param d     is set to the value at the requested time
+     *
+     *  @return status code
+     *   - SMART_OK                  : the value at the given time is returned
+     *   - SMART_NODATA              : the time is outside of the kept time range (or no time-indexed
+     *                                 history is configured)
+     *   - SMART_UNSUBSCRIBED        : the client is not subscribed
+     *   - SMART_DISCONNECTED        : the client is not connected to a server
+     */
+    Smart::StatusCode getUpdateAt(const TimePoint &time, DataType &d)
+    {
+    	if(disconnected_guard.trigger_value() == true)
+    		return Smart::StatusCode::SMART_DISCONNECTED;
+    	if(unsubscribed_guard.trigger_value() == true)
+    		return Smart::StatusCode::SMART_UNSUBSCRIBED;
+
+    	auto history = std::atomic_load(&time_history);
+    	if(!history || !history->getAt(time, d))
+    		return Smart::StatusCode::SMART_NODATA;
+    	return Smart::StatusCode::SMART_OK;
+    }
+
+    /** Non-blocking call to return all kept updates within the time range [start, stop].
+     *
+     *  @param start    the begin of the requested time range
+     *  @param stop     the end of the requested time range
+     *  @param updates  is set to the updates within this time range (ordered by their source timestamps)
+     *
+     *  @return status code
+     *   - SMART_OK                  : at least one update is returned
+     *   - SMART_NODATA              : no update lies within the given time range (or no time-indexed
+     *                                 history is configured)
+     *   - SMART_UNSUBSCRIBED        : the client is not subscribed
+     *   - SMART_DISCONNECTED        : the client is not connected to a server
+     */
+    Smart::StatusCode getUpdatesBetween(const TimePoint &start, const TimePoint &stop, std::vector<DataType> &updates)
+    {
+    	updates.clear();
+    	if(disconnected_guard.trigger_value() == true)
+    		return Smart::StatusCode::SMART_DISCONNECTED;
+    	if(unsubscribed_guard.trigger_value() == true)
+    		return Smart::StatusCode::SMART_UNSUBSCRIBED;
+
+    	auto history = std::atomic_load(&time_history);
+    	if(!history || !history->getBetween(start, stop, updates))
+    		return Smart::StatusCode::SMART_NODATA;
+    	return Smart::StatusCode::SMART_OK;
     }
 
     /** Blocking call which waits until the next update is received.
@@ -463,19 +893,15 @@ public:
 		try {
 			// because the getUpdateWait method can be called multiple times in parallel
 			// from different threads, while a WaitSet can only be used from a single thread,
-			// therefore we need to create a new WaitSet for each separate call of getUpdateWait
-			dds::core::cond::WaitSet wait_set;
-			// new-data condition is triggered each time a new value becomes available
-			wait_set += new_data_guard;
-			wait_set += disconnected_guard;
-			wait_set += unsubscribed_guard;
-			wait_set += nonblocking_guard;
+			// each call borrows an own WaitSet (with the guards already attached) from the pool
+			auto wait_set = wait_sets.acquire();
 
 			// unlock the connection mutex so the pattern remains responsive
 			connection_lock.unlock();
 
 			// blocking wait until one of the specified conditions becomes true (or a timeout occurs)
-			auto active_conditions = wait_set.wait(timeout);
+			// (the new-data condition is triggered each time a new value becomes available)
+			const auto &active_conditions = wait_set.wait(timeout);
 
 			if(active_conditions.size() == 0) {
 				// if no specified conditions are active, then the only thing that could have happened is a timeout
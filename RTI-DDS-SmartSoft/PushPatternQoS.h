@@ -47,6 +47,8 @@
 
 #include <smartChronoAliases.h>
 
+#include "RTI-DDS-SmartSoft/DDSWriterMemorySettings.h"
+
 namespace SmartDDS {
 
 class PushPatternQoS {
@@ -57,6 +59,7 @@ public:
 		topic_qos << dds::core::policy::Reliability::Reliable();
 		// History=KeepLast(1) means the reader has an internal buffer of one element
 		// this buffered value can be read between updates
+		// (a client that needs every update can increase the depth of its reader, see PushClientPattern::setHistoryDepth)
 		topic_qos << dds::core::policy::History::KeepLast(1);
 		// Exclusive Ownership means there can only be one DataWriter (for a certain Topic) at a time
 		// the typical behavior is that the latest started writer becomes the dominant one
@@ -99,6 +102,12 @@ public:
 		}
 		return writer_qos;
 	}
+
+	static DDSWriterMemorySettings getWriterMemorySettings() {
+		// samples up to 32 KB are served from the writer's pre-allocated pool (larger samples are allocated on demand),
+		// the pool size can be adapted to the actually written sample sizes (see DDSWriterMemorySettings)
+		return DDSWriterMemorySettings(32768);
+	}
 };
 
 } /* namespace SmartDDS */
@@ -44,11 +44,15 @@
 #define RTIDDSSMARTSOFT_PUSHSERVERPATTERN_H_
 
 #include <mutex>
+#include <type_traits>
 
 #include "RTI-DDS-SmartSoft/Component.h"
 #include "RTI-DDS-SmartSoft/PushPatternQoS.h"
 
 #include "RTI-DDS-SmartSoft/DDSAliases.h"
+#include "RTI-DDS-SmartSoft/DDSTypeTraits.h"
+#include "RTI-DDS-SmartSoft/DDSSamplePool.h"
+#include "RTI-DDS-SmartSoft/LocalPushService.h"
 #include "RTI-DDS-SmartSoft/DDSWriterConnector.h"
 
 #include <smartIPushServerPattern_T.h>
@@ -58,14 +62,45 @@ namespace SmartDDS {
 template <class DataType>
 class PushServerPattern : public Smart::IPushServerPattern<DataType> {
 private:
+	using TypeTraits = DDSTypeTraits<DataType>;
+	using SampleType = typename TypeTraits::SampleType;
+
 	Component* component;
 
 	std::mutex server_mutex;
 
-	DDSWriterConnector dds_writer_connector;
-	dds::topic::Topic<dds::core::xtypes::DynamicData> dds_topic;
-	dds::pub::DataWriter<dds::core::xtypes::DynamicData> dds_writer;
+	DDSWriterConnector<SampleType> dds_writer_connector;
+	DDSTopic<SampleType> dds_topic;
+	DDSWriter<SampleType> dds_writer;
+
+	// reuses the writer samples so that steady-state publishing does not allocate
+	DDSSamplePool<DataType> sample_pool;
 
+	// the in-process delivery path for clients within the same process (see LocalServiceRegistry)
+	LocalServiceRegistry::ServiceKey local_service_key;
+	std::shared_ptr<LocalPushService<DataType>> local_service;
+
+
+	void write_sample(const DataType &data, std::false_type)
+	{
+		// the pooled sample is given back after the write
+		auto sample = sample_pool.acquire(data);
+		dds_writer.write(*sample);
+		dds_writer_connector.observe(*sample);
+	}
+	void write_sample(const DataType &data, std::true_type)
+	{
+		// the loaned sample lives in the shared-memory segment, so co-located readers get it without a payload copy
+		auto sample = dds_writer->get_loan();
+		try {
+			TypeTraits::toSample(data, *sample);
+		} catch (...) {
+			dds_writer->discard_loan(*sample);
+			throw;
+		}
+		// writing the sample returns the loan to the middleware
+		dds_writer.write(*sample);
+	}
 
 	/** implements server-initiated-disconnect (SID)
 	 *
@@ -78,22 +113,41 @@ private:
 	virtual void serverInitiatedDisconnect() override
 	{
 		std::unique_lock<std::mutex> server_lock(server_mutex);
+		local_service->deactivate();
+		LocalServiceRegistry::instance().unregisterService(local_service_key, local_service);
 		dds_writer_connector.reset(dds_writer);
 		component->DDS().resetTopic(dds_topic);
 	}
 
 public:
-	PushServerPattern(Component* component, const std::string& serviceName, const Smart::Duration &cycleTime = Smart::Duration::zero())
+	/** Constructor
+	 *
+	 * @param component    the management class of the component
+	 * @param serviceName  the name of the service (i.e. the port-name)
+	 * @param cycleTime    the expected update period (if any)
+	 * @param batching     optional writer-side batching for high-rate small data (disabled by default),
+	 *                     which moves the prescale/rate filtering of the subscriptions to the readers (see DDSBatchSettings)
+	 * @param async_publishing  optional asynchronous, bandwidth-shaped publishing for bulk data (disabled by default)
+	 */
+	PushServerPattern(Component* component, const std::string& serviceName, const Smart::Duration &cycleTime = Smart::Duration::zero(),
+			const DDSBatchSettings &batching = DDSBatchSettings(),
+			const DDSAsyncPublishSettings &async_publishing = DDSAsyncPublishSettings())
 	:	Smart::IPushServerPattern<DataType>(component, serviceName)
 	,	component(component)
-	,	dds_writer_connector(component, PushPatternQoS::getTopicQoS())
+	,	dds_writer_connector(component, PushPatternQoS::getTopicQoS(), PushPatternQoS::getWriterMemorySettings())
 	,	dds_topic(nullptr)
 	,	dds_writer(nullptr)
 	{
+		dds_writer_connector.setQosProfile(DDSQosProfiles::findWriterProfile("PushPattern", component->getName(), component->getName(), serviceName));
+		dds_writer_connector.setBatching(batching);
+		dds_writer_connector.setAsynchronousPublishing(async_publishing);
 		auto topicName = component->getName()+"::"+serviceName;
-		auto dds_dynamic_type = dds_type<DataType>();
-		dds_topic = component->DDS().findOrCreateTopic(topicName, dds_dynamic_type);
+		dds_topic = TypeTraits::findOrCreateTopic(component->DDS(), topicName);
 		dds_writer = dds_writer_connector.create_new_writer(dds_topic);
+
+		local_service_key = LocalServiceRegistry::ServiceKey(component->DDS().getDomainId(), "PushService::"+topicName);
+		local_service = std::make_shared<LocalPushService<DataType>>(component->getLocalDispatcherPool());
+		LocalServiceRegistry::instance().registerService(local_service_key, local_service);
 	}
 
 	virtual ~PushServerPattern()
@@ -132,8 +186,11 @@ public:
    			if(dds_writer.is_nil())
    				return Smart::StatusCode::SMART_CANCELLED;
 
-   			// write the serialized data
-   			dds_writer.write(serialize(data));
+   			// first deliver the data to the local subscribers (if any) without serialization
+   			local_service->put(data);
+
+   			// write the serialized data (either from the sample pool or as a zero-copy loaned sample)
+   			write_sample(data, std::integral_constant<bool, TypeTraits::zero_copy>());
 
 			// as long as no exceptions are thrown we assume that the communication was successful
 			return Smart::StatusCode::SMART_OK;
@@ -142,6 +199,36 @@ public:
 			return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
 		}
     }
+
+    /** returns the statistics of the measured samples of the writer (only collected if a
+     *  sampling period is configured within the writer memory settings of the pattern QoS)
+     */
+    DDSWriterMemoryStatistics getWriterMemoryStatistics() const
+    {
+    	return dds_writer_connector.getMemoryStatistics();
+    }
+
+    /** Immediately sends all samples that are accumulated within the current batch
+     *  (only relevant if batching is enabled).
+     *
+     *  @return status code
+     *    - SMART_OK                  : everything is ok
+     *    - SMART_CANCELLED           : server is in the process of shutting down
+     *    - SMART_ERROR_COMMUNICATION : communication problems
+     */
+    Smart::StatusCode flush()
+    {
+    	std::unique_lock<std::mutex> server_lock(server_mutex);
+    	try {
+    		if(dds_writer.is_nil())
+    			return Smart::StatusCode::SMART_CANCELLED;
+    		dds_writer->flush();
+    		return Smart::StatusCode::SMART_OK;
+    	} catch (std::exception &ex) {
+    		std::cerr << ex.what() << std::endl;
+    		return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
+    	}
+    }
 };
 
 } /* namespace SmartDDS */
@@ -45,33 +45,161 @@
 
 #include <dds/dds.hpp>
 
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include <smartStatusCode.h>
+#include <smartITimerManager.h>
+
+#include "RTI-DDS-SmartSoft/CorrelationId.h"
+#include "RTI-DDS-SmartSoft/CorrelationTable.h"
+#include "RTI-DDS-SmartSoft/DDSTypeTraits.h"
+
 namespace SmartDDS {
 
 template <typename AnswerObjectType>
 class QueryClientAnswerTrigger {
+public:
+	// the completion callback of asynchronous queries (the answer is only valid if the status is SMART_OK)
+	using AnswerCallback = std::function<void(const Smart::StatusCode &status, const AnswerObjectType &answer)>;
+	// cancels the timeout timer of an asynchronous query (see QueryClientTimeoutHandler)
+	using TimeoutCanceller = void (*)(Smart::ITimerManager *timer_manager, const Smart::ITimerManager::TimerId &timer_id);
+
 private:
+	// the answer is written from the receiving thread and read by the (possibly blocked) requesting thread
+	mutable std::mutex answer_mutex;
 	AnswerObjectType answer;
 	dds::core::cond::GuardCondition has_answer_guard;
 	dds::core::cond::GuardCondition request_discarded_guard;
+
+	// if a callback is set, then the query is completed by calling it (instead of triggering the guards above)
+	bool is_async;
+	AnswerCallback answer_callback;
+	std::atomic<bool> completed;
+
+	Smart::ITimerManager *timer_manager;
+	Smart::ITimerManager::TimerId timer_id;
+	TimeoutCanceller timeout_canceller;
+
+	// calls the answer callback at most once and cancels a still pending timeout timer
+	inline void complete(const Smart::StatusCode &status, const AnswerObjectType &answer_object) {
+		if(completed.exchange(true) == true) {
+			return;
+		}
+		std::unique_lock<std::mutex> answer_lock(answer_mutex);
+		auto callback = std::move(answer_callback);
+		answer_callback = nullptr;
+		auto pending_timer_manager = timer_manager;
+		timer_manager = nullptr;
+		answer_lock.unlock();
+
+		if(pending_timer_manager != nullptr) {
+			timeout_canceller(pending_timer_manager, timer_id);
+		}
+		callback(status, answer_object);
+	}
+
 public:
 	QueryClientAnswerTrigger()
 	:	answer()
+	,	is_async(false)
+	,	completed(false)
+	,	timer_manager(nullptr)
+	,	timer_id(-1)
+	,	timeout_canceller(nullptr)
 	{  }
 
+	// prepares a pooled trigger for its next query (see QueryClientAnswerTriggerPool)
+	inline void reset() {
+		std::unique_lock<std::mutex> answer_lock(answer_mutex);
+		answer = AnswerObjectType();
+		has_answer_guard.trigger_value(false);
+		request_discarded_guard.trigger_value(false);
+		is_async = false;
+		answer_callback = nullptr;
+		timer_manager = nullptr;
+		timer_id = -1;
+		completed = false;
+	}
+
+	// turns this trigger into the completion of an asynchronous query (must be set before the query is sent)
+	inline void setAnswerCallback(const AnswerCallback &callback) {
+		std::unique_lock<std::mutex> answer_lock(answer_mutex);
+		is_async = true;
+		answer_callback = callback;
+	}
+	inline bool hasAnswerCallback() const {
+		std::unique_lock<std::mutex> answer_lock(answer_mutex);
+		return is_async;
+	}
+	inline bool isCompleted() const {
+		return completed;
+	}
+
+	/** registers the timeout timer of an asynchronous query
+	 *  @return false if the query has already been completed (then the caller has to cancel the timer itself)
+	 */
+	inline bool setTimeoutTimer(Smart::ITimerManager *manager, const Smart::ITimerManager::TimerId &id, TimeoutCanceller canceller) {
+		std::unique_lock<std::mutex> answer_lock(answer_mutex);
+		if(completed == true) {
+			return false;
+		}
+		timer_manager = manager;
+		timer_id = id;
+		timeout_canceller = canceller;
+		return true;
+	}
+
 	inline bool hasAnswer() const {
 		return has_answer_guard.trigger_value();
 	}
 
-	inline void triggerNewAnswerData(const dds::core::xtypes::DynamicData &answer_data) {
-		convert(answer_data, answer);
+	inline void triggerNewAnswerData(const typename DDSTypeTraits<AnswerObjectType>::SampleType &answer_data) {
+		{
+			std::unique_lock<std::mutex> answer_lock(answer_mutex);
+			if(is_async) {
+				answer_lock.unlock();
+				AnswerObjectType answer_object;
+				DDSTypeTraits<AnswerObjectType>::fromSample(answer_data, answer_object);
+				complete(Smart::StatusCode::SMART_OK, answer_object);
+				return;
+			}
+			DDSTypeTraits<AnswerObjectType>::fromSample(answer_data, answer);
+		}
+		has_answer_guard.trigger_value(true);
+	}
+
+	// used by the local (in-process) query path, see LocalQueryService
+	inline void triggerNewAnswer(const AnswerObjectType &answer_object) {
+		{
+			std::unique_lock<std::mutex> answer_lock(answer_mutex);
+			if(is_async) {
+				answer_lock.unlock();
+				complete(Smart::StatusCode::SMART_OK, answer_object);
+				return;
+			}
+			answer = answer_object;
+		}
 		has_answer_guard.trigger_value(true);
 	}
 
 	inline AnswerObjectType getAnswerObject() const {
+		std::unique_lock<std::mutex> answer_lock(answer_mutex);
 		return answer;
 	}
 
-	inline void triggerDiscard() {
+	// the status is only used to complete asynchronous queries (blocking queries determine it themselves)
+	inline void triggerDiscard(const Smart::StatusCode &status = Smart::StatusCode::SMART_CANCELLED) {
+		std::unique_lock<std::mutex> answer_lock(answer_mutex);
+		if(is_async) {
+			answer_lock.unlock();
+			complete(status, AnswerObjectType());
+			return;
+		}
+		answer_lock.unlock();
 		request_discarded_guard.trigger_value(true);
 	}
 
@@ -83,6 +211,128 @@ public:
 	}
 };
 
+/** A pool of answer triggers, so that the two guard conditions of a trigger are not
+ *  created anew for each query.
+ *
+ *  A trigger is returned into the pool (and reset) once its last shared_ptr is released,
+ *  which can also happen after the pool itself has been destroyed.
+ */
+template <typename AnswerObjectType>
+class QueryClientAnswerTriggerPool {
+public:
+	using Trigger = QueryClientAnswerTrigger<AnswerObjectType>;
+
+private:
+	struct Storage {
+		std::mutex pool_mutex;
+		std::vector<std::unique_ptr<Trigger>> free_triggers;
+		size_t max_pool_size;
+	};
+	std::shared_ptr<Storage> storage;
+
+public:
+	QueryClientAnswerTriggerPool(const size_t &max_pool_size = 1024)
+	:	storage(std::make_shared<Storage>())
+	{
+		storage->max_pool_size = max_pool_size;
+	}
+
+	std::shared_ptr<Trigger> acquire()
+	{
+		std::unique_ptr<Trigger> trigger;
+		{
+			std::unique_lock<std::mutex> pool_lock(storage->pool_mutex);
+			if(!storage->free_triggers.empty()) {
+				trigger = std::move(storage->free_triggers.back());
+				storage->free_triggers.pop_back();
+			}
+		}
+		if(!trigger) {
+			trigger.reset(new Trigger());
+		}
+		std::weak_ptr<Storage> weak_storage = storage;
+		return std::shared_ptr<Trigger>(trigger.release(), [weak_storage](Trigger *released_trigger) {
+			std::unique_ptr<Trigger> owned_trigger(released_trigger);
+			if(auto pool_storage = weak_storage.lock()) {
+				owned_trigger->reset();
+				std::unique_lock<std::mutex> pool_lock(pool_storage->pool_mutex);
+				if(pool_storage->free_triggers.size() < pool_storage->max_pool_size) {
+					pool_storage->free_triggers.push_back(std::move(owned_trigger));
+				}
+			}
+		});
+	}
+};
+
+/** Expires the timeout timers of asynchronous queries (see QueryClientPattern::queryAsync).
+ *
+ *  A single handler instance (which is never destroyed) is shared by all clients, so that a timer which
+ *  expires concurrently to the destruction of a client does not call a dangling handler. The pending
+ *  queries of the client are only referred to weakly from within the act of each timer.
+ */
+template <typename AnswerObjectType>
+class QueryClientTimeoutHandler : public Smart::ITimerHandler {
+public:
+	using TriggerPtr = std::shared_ptr<QueryClientAnswerTrigger<AnswerObjectType>>;
+	using PendingQueries = CorrelationTable<TriggerPtr>;
+
+private:
+	struct TimeoutAct {
+		std::weak_ptr<PendingQueries> pending_queries;
+		CorrelationKey query_key;
+	};
+
+	QueryClientTimeoutHandler() = default;
+
+	// the act is owned by the timer manager until the timer is either cancelled or expired
+	static void cancelTimeout(Smart::ITimerManager *timer_manager, const Smart::ITimerManager::TimerId &timer_id)
+	{
+		const void *act = nullptr;
+		if(timer_manager->cancelTimer(timer_id, &act) == 0) {
+			delete static_cast<const TimeoutAct*>(act);
+		}
+	}
+
+public:
+	static QueryClientTimeoutHandler& instance()
+	{
+		static QueryClientTimeoutHandler *handler = new QueryClientTimeoutHandler();
+		return *handler;
+	}
+
+	// the pending query is completed with SMART_TIMEOUT if it is still pending after the given timeout
+	void scheduleTimeout(
+			Smart::ITimerManager *timer_manager,
+			const std::shared_ptr<PendingQueries> &pending_queries,
+			const CorrelationKey &query_key,
+			const TriggerPtr &answer_trigger,
+			const Smart::Duration &timeout)
+	{
+		auto act = new TimeoutAct{pending_queries, query_key};
+		auto timer_id = timer_manager->scheduleTimer(this, act, timeout);
+		if(!answer_trigger->setTimeoutTimer(timer_manager, timer_id, &QueryClientTimeoutHandler::cancelTimeout)) {
+			// the answer was faster
+			cancelTimeout(timer_manager, timer_id);
+		}
+	}
+
+	virtual void timerExpired(const Smart::TimePoint &, const void *act) override
+	{
+		std::unique_ptr<const TimeoutAct> timeout_act(static_cast<const TimeoutAct*>(act));
+		if(auto pending_queries = timeout_act->pending_queries.lock()) {
+			TriggerPtr answer_trigger;
+			if(pending_queries->take(timeout_act->query_key, answer_trigger)) {
+				answer_trigger->triggerDiscard(Smart::StatusCode::SMART_TIMEOUT);
+			}
+		}
+	}
+
+	virtual void timerDeleted(const void *act) override
+	{
+		delete static_cast<const TimeoutAct*>(act);
+	}
+};
+
 } /* namespace SmartDDS */
 
 #endif /* RTIDDSSMARTSOFT_QUERYCLIENTANSWERTRIGGER_H_ */
@@ -43,52 +43,135 @@
 #ifndef RTIDDSSMARTSOFT_QUERYCLIENTPATTERN_H_
 #define RTIDDSSMARTSOFT_QUERYCLIENTPATTERN_H_
 
-#include <map>
 #include <mutex>
+#include <deque>
+#include <vector>
+#include <future>
 #include <memory>
+#include <stdexcept>
+#include <functional>
+#include <condition_variable>
 
 #include "RTI-DDS-SmartSoft/Component.h"
+#include "RTI-DDS-SmartSoft/AsyncConnector.h"
 #include "RTI-DDS-SmartSoft/CorrelationId.h"
 
 #include "RTI-DDS-SmartSoft/DDSReaderConnector.h"
+#include "RTI-DDS-SmartSoft/DDSWaitSetPool.h"
 #include "RTI-DDS-SmartSoft/DDSWriterConnector.h"
+#include "RTI-DDS-SmartSoft/DDSTypeTraits.h"
 
 #include "RTI-DDS-SmartSoft/QueryPatternQoS.h"
 #include "RTI-DDS-SmartSoft/QueryClientAnswerTrigger.h"
+#include "RTI-DDS-SmartSoft/CorrelationTable.h"
+#include "RTI-DDS-SmartSoft/LocalQueryService.h"
 
 #include <smartIQueryClientPattern_T.h>
 
 namespace SmartDDS {
 
+/** The exception of a failed QueryClientPattern::queryAsync(request) future, which
+ *  provides the status code of the failure (e.g. SMART_TIMEOUT or SMART_DISCONNECTED).
+ */
+class QueryAsyncError : public std::runtime_error {
+private:
+	Smart::StatusCode status;
+public:
+	QueryAsyncError(const Smart::StatusCode &status)
+	:	std::runtime_error("asynchronous query failed")
+	,	status(status)
+	{  }
+
+	inline Smart::StatusCode getStatusCode() const {
+		return status;
+	}
+};
+
+/// the delivery order of the answers of QueryClientPattern::queryPipelined(...)
+enum class QueryPipelineOrder {
+	// each answer is delivered as soon as it is received
+	COMPLETION_ORDER = 0,
+	// the answers are delivered in the order of their requests (later answers wait for earlier ones)
+	REQUEST_ORDER = 1
+};
+
 template<class RequestType, class AnswerType>
 class QueryClientPattern
 :	public Smart::IQueryClientPattern<RequestType, AnswerType>
-,	public DynamicDataReaderListener
+,	public DDSReaderListener<typename DDSTypeTraits<AnswerType>::SampleType>
+,	public LocalServiceClient
 {
 private:
+	using RequestTraits = DDSTypeTraits<RequestType>;
+	using RequestSampleType = typename RequestTraits::SampleType;
+	using AnswerTraits = DDSTypeTraits<AnswerType>;
+	using AnswerSampleType = typename AnswerTraits::SampleType;
 
 	Component *component;
 
 	std::recursive_mutex connection_mutex;
+	// the background connect of connectAsync(...), which is completed before disconnecting
+	AsyncConnector async_connector;
 
-	std::recursive_mutex answer_mutex;
-	std::map<CorrelationId, std::shared_ptr<QueryClientAnswerTrigger<AnswerType>>> answer_cache;
+	using AnswerTriggerPtr = std::shared_ptr<QueryClientAnswerTrigger<AnswerType>>;
+
+	// the pending queries (hashed by their raw correlation identity and sharded to reduce lock contention)
+	CorrelationTable<AnswerTriggerPtr> answer_table;
+	QueryClientAnswerTriggerPool<AnswerType> answer_trigger_pool;
+
+	// the pending asynchronous queries (shared, because their timeout timers refer to it, see QueryClientTimeoutHandler)
+	using TimeoutHandler = QueryClientTimeoutHandler<AnswerType>;
+	std::shared_ptr<typename TimeoutHandler::PendingQueries> async_queries;
 
 	// this helpers allow checking if a remote end-point actually responds during a connection phase (see connect(...) method)
-	DDSWriterConnector dds_writer_connector;
-	DDSReaderConnector dds_reader_connector;
+	DDSWriterConnector<RequestSampleType> dds_writer_connector;
+	DDSReaderConnector<AnswerSampleType> dds_reader_connector;
 
-	DynamicDataTopic dds_request_topic;
-	DynamicDataWriter dds_request_writer;
+	DDSTopic<RequestSampleType> dds_request_topic;
+	DDSWriter<RequestSampleType> dds_request_writer;
 
-	DynamicDataTopic dds_reply_topic;
-	DynamicDataFilteredTopic dds_filtered_reply_topic;
-	DynamicDataReader dds_filtered_reply_reader;
+	DDSTopic<AnswerSampleType> dds_reply_topic;
+	DDSFilteredTopic<AnswerSampleType> dds_filtered_reply_topic;
+	DDSReader<AnswerSampleType> dds_filtered_reply_reader;
 
 	dds::core::cond::GuardCondition disconnected_guard;
 	dds::core::cond::GuardCondition nonblocking_guard;
 
-    void on_liveliness_changed(DynamicDataReader&, const LivelinessChangedStatus &status)
+	// the WaitSets of queryReceiveWait(...) with the above two guards attached
+	DDSWaitSetPool wait_sets;
+
+	// the in-process delivery path is used if the server lives in the same process (see LocalServiceRegistry)
+	std::shared_ptr<LocalQueryService<RequestType, AnswerType>> local_service;
+	// identifies this client's local connection within the query IDs (a new one is created for each connect)
+	ConnectionId local_connection_id;
+
+	// the identities of the requests are assigned explicitly (instead of being generated within write()), so that
+	// each query is registered before its request is written (the answer might arrive before write() returns);
+	// both members are guarded by the connection_mutex
+	ConnectionId requester_id;
+	int64_t last_request_sequence_number;
+
+	rti::core::SampleIdentity next_request_identity()
+	{
+		return rti::core::SampleIdentity(requester_id, rti::core::SequenceNumber(++last_request_sequence_number));
+	}
+	void write_request(const RequestType &request, const rti::core::SampleIdentity &request_identity)
+	{
+		rti::pub::WriteParams params;
+		params.identity(request_identity);
+
+		// sends the query request (using the extended write method)
+		auto request_sample = RequestTraits::toSample(request);
+		dds_request_writer->write(request_sample, params);
+		dds_writer_connector.observe(request_sample);
+	}
+
+	virtual void onLocalServiceDisconnect() override
+	{
+		disconnected_guard.trigger_value(true);
+	}
+
+    void on_liveliness_changed(DDSReader<AnswerSampleType>&, const LivelinessChangedStatus &status)
     {
     	if(status.alive_count() == 0) {
     		disconnected_guard.trigger_value(true);
@@ -96,7 +179,7 @@ private:
     		disconnected_guard.trigger_value(false);
     	}
     }
-    void on_data_available(DynamicDataReader &reader)
+    void on_data_available(DDSReader<AnswerSampleType> &reader)
     {
     	// do not grab the mutex if client is in the process of shutting down or disconnecting
 		if(this->is_shutting_down() || disconnected_guard.trigger_value() == true)
@@ -104,14 +187,16 @@ private:
 
 		// consume all incoming answers
 		auto answers = reader.take();
-		for(auto answer: answers) {
+		for(const auto &answer: answers) {
 			if(answer.info().valid()) {
-				std::unique_lock<std::recursive_mutex> answer_lock(answer_mutex);
-				auto answer_id = CorrelationId::createRelatedId(answer.info());
-				auto query_it = answer_cache.find(answer_id);
-				if(query_it != answer_cache.end()) {
+				CorrelationKey answer_key(answer.info()->related_original_publication_virtual_sample_identity());
+				AnswerTriggerPtr answer_trigger;
+				if(answer_table.find(answer_key, answer_trigger)) {
 					// this call overrides the internal answer object copy for the given ID
-					query_it->second->triggerNewAnswerData(answer.data());
+					answer_trigger->triggerNewAnswerData(answer.data());
+				} else if(async_queries->take(answer_key, answer_trigger)) {
+					// this call directly completes the asynchronous query (see queryAsync)
+					answer_trigger->triggerNewAnswerData(answer.data());
 				}
 			}
 		}
@@ -130,13 +215,16 @@ public:
 	QueryClientPattern(Component* component)
 	:	Smart::IQueryClientPattern<RequestType, AnswerType>(component)
 	,	component(component)
-	,	dds_writer_connector(component, QueryPatternQoS::getRequestTopicQoS())
+	,	async_queries(std::make_shared<typename TimeoutHandler::PendingQueries>())
+	,	dds_writer_connector(component, QueryPatternQoS::getRequestTopicQoS(), QueryPatternQoS::getRequestWriterMemorySettings())
 	,	dds_reader_connector(component, QueryPatternQoS::getReplyTopicQoS())
 	,	dds_request_topic(nullptr)
 	,	dds_request_writer(nullptr)
 	,	dds_reply_topic(nullptr)
 	,	dds_filtered_reply_topic(nullptr)
 	,	dds_filtered_reply_reader(nullptr)
+	,	wait_sets({disconnected_guard, nonblocking_guard})
+	,	last_request_sequence_number(0)
 	{
 		// by default, the client initializes in the disconnected state
 		disconnected_guard.trigger_value(true);
@@ -164,13 +252,16 @@ public:
 	QueryClientPattern(Component* component, const std::string& server, const std::string& service)
 	:	Smart::IQueryClientPattern<RequestType, AnswerType>(component)
 	,	component(component)
-	,	dds_writer_connector(component, QueryPatternQoS::getRequestTopicQoS())
+	,	async_queries(std::make_shared<typename TimeoutHandler::PendingQueries>())
+	,	dds_writer_connector(component, QueryPatternQoS::getRequestTopicQoS(), QueryPatternQoS::getRequestWriterMemorySettings())
 	,	dds_reader_connector(component, QueryPatternQoS::getReplyTopicQoS())
 	,	dds_request_topic(nullptr)
 	,	dds_request_writer(nullptr)
 	,	dds_reply_topic(nullptr)
 	,	dds_filtered_reply_topic(nullptr)
 	,	dds_filtered_reply_reader(nullptr)
+	,	wait_sets({disconnected_guard, nonblocking_guard})
+	,	last_request_sequence_number(0)
 	{
 		// by default, the client initializes in the disconnected state
 		disconnected_guard.trigger_value(true);
@@ -212,6 +303,9 @@ public:
      */
     virtual Smart::StatusCode connect(const std::string& server, const std::string& service) override
     {
+    	// a pending connectAsync(...) is completed first (it holds the connection mutex while connecting)
+    	async_connector.wait();
+
     	std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
 
     	// we by default disconnect the previous connection
@@ -223,16 +317,26 @@ public:
 		auto requestTopicName = server+"::"+service+"::RequestTopic";
 		auto replyTopicName = server+"::"+service+"::ReplyTopic";
 
-		// the dynamic DDS types are determined using external template methods
-		auto dds_request_type = dds_type<RequestType>();
-		auto dds_answer_type = dds_type<AnswerType>();
+		// a server within the same process is connected directly (bypassing DDS)
+		local_service = LocalServiceRegistry::instance().findService<LocalQueryService<RequestType, AnswerType>>(
+				LocalServiceRegistry::ServiceKey(component->DDS().getDomainId(), "QueryService::"+server+"::"+service));
+		if(local_service && local_service->attach(this)) {
+			local_connection_id = ConnectionId::createUnique();
+			disconnected_guard.trigger_value(false);
+			return Smart::StatusCode::SMART_OK;
+		}
+		local_service = nullptr;
 
 		try {
 			// if the related query server is in the same component, then the topic is already defined and we can simply reuse it
-			dds_request_topic = component->DDS().findOrCreateTopic(requestTopicName, dds_request_type);
-			dds_reply_topic = component->DDS().findOrCreateTopic(replyTopicName, dds_answer_type);
+			// (the DDS types are determined by the DDSTypeTraits, i.e. either DynamicData or an IDL-generated type)
+			dds_request_topic = RequestTraits::findOrCreateTopic(component->DDS(), requestTopicName);
+			dds_reply_topic = AnswerTraits::findOrCreateTopic(component->DDS(), replyTopicName);
+
+			dds_writer_connector.setQosProfile(DDSQosProfiles::findWriterProfile("QueryPattern", component->getName(), server, service));
+			dds_reader_connector.setQosProfile(DDSQosProfiles::findReaderProfile("QueryPattern", component->getName(), server, service));
 
-			auto timeout = std::chrono::seconds(1);
+			auto timeout = component->getConnectionTimeout();
 			auto connection_status = dds_writer_connector.reconnect(dds_request_writer, dds_request_topic, timeout);
 
 			if(connection_status != Smart::StatusCode::SMART_OK) {
@@ -241,7 +345,7 @@ public:
 			}
 
 			// initiate the connection ID from the request writer
-			ConnectionId requester_id(dds_request_writer);
+			requester_id = ConnectionId(dds_request_writer);
 
 			// create a content filtered topic
 			dds_filtered_reply_topic = component->DDS().findOrCreateClientFilteredTopic(dds_reply_topic, requester_id);
@@ -264,6 +368,27 @@ public:
     	return Smart::StatusCode::SMART_ERROR;
     }
 
+    /** Asynchronously connect this service requestor to the denoted service provider.
+     *
+     *  This method returns immediately and performs the connect(server, service) call in the
+     *  background. This allows all client ports of a component to establish their connections
+     *  in parallel (instead of one after another) and to collect the results afterwards.
+     *  The maximal waiting time of each connection attempt is configured by the component
+     *  (see Component::setConnectionTimeout). A pending background connect is completed
+     *  before disconnect() proceeds (which also applies to the destructor).
+     *
+     * @param server     name of the server (i.e. the component-name to connect to)
+     * @param service    name of the service (i.e. the port-name of the component to connect to)
+     *
+     * @return a future providing the status code of the connect(server, service) call
+     */
+    std::future<Smart::StatusCode> connectAsync(const std::string& server, const std::string& service)
+    {
+    	return async_connector.start([this, server, service]() {
+    		return this->connect(server, service);
+    	});
+    }
+
     /** Disconnect the service requestor from the service provider.
      *
      *  It is no problem to change the connection to a service provider at any
@@ -284,15 +409,23 @@ public:
 		// first thing is to change the disconnected guard to true so no blocking calls will be used from here on
 		disconnected_guard.trigger_value(true);
 
-		std::unique_lock<std::recursive_mutex> answer_lock(answer_mutex);
-		for(const auto& query: answer_cache) {
-			query.second->triggerDiscard();
+		for(const auto& answer_trigger: answer_table.takeAll()) {
+			answer_trigger->triggerDiscard();
 		}
-		answer_cache.clear();
-		answer_lock.unlock();
+		for(const auto& answer_trigger: async_queries->takeAll()) {
+			answer_trigger->triggerDiscard(Smart::StatusCode::SMART_DISCONNECTED);
+		}
+
+		// a pending connectAsync(...) is completed first (the connection is then closed below)
+		async_connector.wait();
 
 		std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
 
+		if(local_service) {
+			local_service->detach(this);
+			local_service = nullptr;
+		}
+
 		// release the resource for the request-channel
 		dds_writer_connector.reset(dds_request_writer);
 		component->DDS().resetTopic(dds_request_topic);
@@ -373,20 +506,31 @@ public:
 		try {
 			std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
 
-			// use write-parameters to determine the generated sample ID
-			rti::pub::WriteParams params;
-			params.replace_automatic_values(true);
+			if(local_service) {
+				// the request is directly dispatched to the local server, which answers through the answer-trigger
+				auto answer_trigger = answer_trigger_pool.acquire();
+				auto query_id = local_service->query(local_connection_id, request, answer_trigger);
+				if(!query_id) {
+					return Smart::StatusCode::SMART_DISCONNECTED;
+				}
+				id = query_id;
 
-			// sends the query request (using the extended write method)
-			dds_request_writer->write(serialize(request), params);
-			// get the generated sample ID
-			auto sample_id = params.identity();
-			id = std::make_shared<CorrelationId>(sample_id);
+				answer_table.insert(query_id->getKey(), answer_trigger);
+				return Smart::StatusCode::SMART_OK;
+			}
 
-			std::unique_lock<std::recursive_mutex> answer_lock(answer_mutex);
 			// create an answer-trigger that will be used to store the received answer
 			// and trigger all blocking queryReceiveWait calls to release for the given ID
-			answer_cache[sample_id] = std::make_shared<QueryClientAnswerTrigger<AnswerType>>();
+			auto sample_id = next_request_identity();
+			CorrelationKey query_key(sample_id);
+			answer_table.insert(query_key, answer_trigger_pool.acquire());
+			try {
+				write_request(request, sample_id);
+			} catch (...) {
+				answer_table.erase(query_key);
+				throw;
+			}
+			id = std::make_shared<CorrelationId>(sample_id);
 			return Smart::StatusCode::SMART_OK;
 		} catch (std::exception &ex) {
 			std::cerr << ex.what() << std::endl;
@@ -426,23 +570,22 @@ public:
     	if(disconnected_guard.trigger_value() == true)
     		return Smart::StatusCode::SMART_DISCONNECTED;
 
-    	std::unique_lock<std::recursive_mutex> answer_lock(answer_mutex);
-
     	auto dds_id = std::dynamic_pointer_cast<CorrelationId>(id);
     	if(!dds_id) {
     		return Smart::StatusCode::SMART_WRONGID;
     	}
-    	auto foundQueryIt = answer_cache.find(*dds_id);
-    	if(foundQueryIt == answer_cache.end()) {
-    		// the requested ID is not within the internal pending queries cache (so it is invalid)
+    	auto query_key = dds_id->getKey();
+    	AnswerTriggerPtr answer_trigger;
+    	if(!answer_table.find(query_key, answer_trigger)) {
+    		// the requested ID is not within the internal pending queries table (so it is invalid)
     		return Smart::StatusCode::SMART_WRONGID;
     	}
 
-    	if(foundQueryIt->second->hasAnswer()) {
+    	if(answer_trigger->hasAnswer()) {
     		// copy the answer object to the answer out-value
-    		answer = foundQueryIt->second->getAnswerObject();
-    		// as we have consumed the answer, we can free the cache entry
-    		answer_cache.erase(foundQueryIt);
+    		answer = answer_trigger->getAnswerObject();
+    		// as we have consumed the answer, we can free the table entry
+    		answer_table.erase(query_key);
     		return Smart::StatusCode::SMART_OK;
     	} else {
     		return Smart::StatusCode::SMART_NODATA;
@@ -487,38 +630,27 @@ public:
     	if(disconnected_guard.trigger_value() == true)
     		return Smart::StatusCode::SMART_DISCONNECTED;
 
-    	std::unique_lock<std::recursive_mutex> answer_lock(answer_mutex);
-
     	auto dds_id = std::dynamic_pointer_cast<CorrelationId>(id);
     	if(!dds_id) {
     		return Smart::StatusCode::SMART_WRONGID;
     	}
-    	auto foundQueryIt = answer_cache.find(*dds_id);
-    	if(foundQueryIt == answer_cache.end()) {
-    		// the requested ID is not within the internal pending queries cache (so it is invalid)
+    	auto query_key = dds_id->getKey();
+		// here we copy the shared pointer so its content will not be deleted unintentionally
+		// while we wait for an answer below
+    	AnswerTriggerPtr answer_ptr;
+    	if(!answer_table.find(query_key, answer_ptr)) {
+    		// the requested ID is not within the internal pending queries table (so it is invalid)
     		return Smart::StatusCode::SMART_WRONGID;
     	}
 
     	try {
-    		// here we copy the shared pointer so its content will not be deleted unintentionally
-    		// while we wait for an answer below
-    		auto answer_ptr = foundQueryIt->second;
-
-			dds::core::cond::WaitSet wait_set;
-			wait_set += disconnected_guard;
-			wait_set += nonblocking_guard;
-
-			wait_set += answer_ptr->getDiscardGuard();
-			wait_set += answer_ptr->getResultGuard();
-
-			// unlock the connection mutex so the pattern remains responsive while waiting
-			answer_lock.unlock();
+			// the pooled WaitSet already contains the disconnected and non-blocking guards
+			auto wait_set = wait_sets.acquire();
+			wait_set.attach(answer_ptr->getDiscardGuard());
+			wait_set.attach(answer_ptr->getResultGuard());
 
 			// blocking wait until one of the specified conditions becomes true (or a timeout occurs)
-			auto active_conditions = wait_set.wait(timeout);
-
-			// acquire the lock back, so we can safely access the answer_ptr
-			answer_lock.lock();
+			const auto &active_conditions = wait_set.wait(timeout);
 
 			if(active_conditions.size() == 0) {
 				// if no specified conditions are active, then the only thing that could have happened is a timeout
@@ -541,7 +673,7 @@ public:
 					return Smart::StatusCode::SMART_CANCELLED;
 				} else if(condition == answer_ptr->getResultGuard()) {
 					answer = answer_ptr->getAnswerObject();
-					answer_cache.erase(foundQueryIt);
+					answer_table.erase(query_key);
 					return Smart::StatusCode::SMART_OK;
 				}
 			}
@@ -578,23 +710,260 @@ public:
      */
 	virtual Smart::StatusCode queryDiscard(const Smart::QueryIdPtr id) override
 	{
-		std::unique_lock<std::recursive_mutex> answer_lock(answer_mutex);
-
 		auto dds_id = std::dynamic_pointer_cast<CorrelationId>(id);
 		if (!dds_id) {
 			return Smart::StatusCode::SMART_WRONGID;
 		}
-		auto foundQueryIt = answer_cache.find(*dds_id);
-		if (foundQueryIt == answer_cache.end()) {
+		// remove the table entry
+		AnswerTriggerPtr answer_trigger;
+		if (!answer_table.take(dds_id->getKey(), answer_trigger)) {
 			return Smart::StatusCode::SMART_WRONGID;
 		}
 		// release all blocking queryReceiveWait() calls for the specified query ID
-		foundQueryIt->second->triggerDiscard();
-		// remove the map entry
-		answer_cache.erase(foundQueryIt);
+		answer_trigger->triggerDiscard();
 
 		return Smart::StatusCode::SMART_OK;
 	}
+
+    /** the completion callback of queryAsync(request, callback, timeout)
+     *  (the answer is only valid if the status code is SMART_OK)
+     */
+    using AnswerCallback = typename QueryClientAnswerTrigger<AnswerType>::AnswerCallback;
+
+    /** Callback-based Asynchronous Query.
+     *
+     *  Sends the request and returns immediately. The callback is called exactly once (if the request
+     *  has been sent successfully) and directly from within the receiving thread of the answer, so it
+     *  should not block. In contrast to queryRequest()/queryReceiveWait(), no thread needs to wait for
+     *  the answer (and no WaitSet is involved). Member function is thread safe and reentrant.
+     *
+     *  @param request  send this request to the server (Communication Object)
+     *  @param callback is called with the answer (or the reason why there will be no answer)
+     *  @param timeout  completes the query with SMART_TIMEOUT if no answer arrived within this time
+     *                  (the default value waits infinitely), the timers are driven by the component's timer manager
+     *
+     *  @return status code:
+     *    - SMART_OK                  : the request has been sent and the callback will be called with either:
+     *                                    - SMART_OK           : the answer is valid
+     *                                    - SMART_TIMEOUT      : no answer arrived within the timeout
+     *                                    - SMART_DISCONNECTED : the client got disconnected before the answer arrived
+     *    - SMART_DISCONNECTED        : request is rejected since client is not connected to a server
+     *                                  (the callback will not be called).
+     *    - SMART_ERROR_COMMUNICATION : communication problems (the callback will not be called).
+     */
+    Smart::StatusCode queryAsync(const RequestType& request, const AnswerCallback &callback, const Smart::Duration &timeout = Smart::Duration::max())
+    {
+		if (disconnected_guard.trigger_value() == true)
+			return Smart::StatusCode::SMART_DISCONNECTED;
+
+		auto answer_trigger = answer_trigger_pool.acquire();
+		std::weak_ptr<typename TimeoutHandler::PendingQueries> weak_queries = async_queries;
+
+		// the answer callback is only set once the query key is known, so that the completion can remove the pending query
+		auto register_query = [&](const CorrelationKey &query_key) {
+			answer_trigger->setAnswerCallback([weak_queries, query_key, callback](const Smart::StatusCode &status, const AnswerType &answer) {
+				if(auto pending_queries = weak_queries.lock()) {
+					pending_queries->erase(query_key);
+				}
+				callback(status, answer);
+			});
+			async_queries->insert(query_key, answer_trigger);
+		};
+
+		try {
+			std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
+
+			CorrelationKey query_key;
+			if(local_service) {
+				auto query_id = local_service->query(local_connection_id, request, answer_trigger, [&](const std::shared_ptr<CorrelationId> &id) {
+					query_key = id->getKey();
+					register_query(query_key);
+				});
+				if(!query_id) {
+					return Smart::StatusCode::SMART_DISCONNECTED;
+				}
+			} else {
+				auto sample_id = next_request_identity();
+				query_key = CorrelationKey(sample_id);
+				register_query(query_key);
+				try {
+					write_request(request, sample_id);
+				} catch (...) {
+					// the callback is not called if the request could not be sent
+					async_queries->erase(query_key);
+					throw;
+				}
+			}
+			connection_lock.unlock();
+
+			if(timeout != Smart::Duration::max() && !answer_trigger->isCompleted()) {
+				TimeoutHandler::instance().scheduleTimeout(component->getTimerManager(), async_queries, query_key, answer_trigger, timeout);
+			}
+			return Smart::StatusCode::SMART_OK;
+		} catch (std::exception &ex) {
+			std::cerr << ex.what() << std::endl;
+			return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
+		}
+
+		return Smart::StatusCode::SMART_ERROR;
+    }
+
+    /** Future-based Asynchronous Query.
+     *
+     *  Same as queryAsync(request, callback, timeout), but the answer is provided through a future.
+     *  If the query fails, the future throws a QueryAsyncError (providing the status code) on get().
+     *
+     *  @param request  send this request to the server (Communication Object)
+     *  @param timeout  see queryAsync(request, callback, timeout)
+     *
+     *  @return the future of the answer
+     */
+    std::future<AnswerType> queryAsync(const RequestType& request, const Smart::Duration &timeout = Smart::Duration::max())
+    {
+    	auto answer_promise = std::make_shared<std::promise<AnswerType>>();
+    	auto answer_future = answer_promise->get_future();
+
+    	auto status = this->queryAsync(request, [answer_promise](const Smart::StatusCode &status, const AnswerType &answer) {
+    		if(status == Smart::StatusCode::SMART_OK) {
+    			answer_promise->set_value(answer);
+    		} else {
+    			answer_promise->set_exception(std::make_exception_ptr(QueryAsyncError(status)));
+    		}
+    	}, timeout);
+
+    	if(status != Smart::StatusCode::SMART_OK) {
+    		answer_promise->set_exception(std::make_exception_ptr(QueryAsyncError(status)));
+    	}
+    	return answer_future;
+    }
+
+    /** the answer handler of queryPipelined(...), called with the position of the related request within the range
+     *  (the answer is only valid if the status code is SMART_OK)
+     */
+    using PipelineAnswerHandler = std::function<void(const size_t &request_index, const Smart::StatusCode &status, const AnswerType &answer)>;
+
+    /** Pipelined Query of a range of requests.
+     *
+     *  Sends the requests of the range [first, last) back-to-back (see queryAsync) while keeping at most
+     *  <I>window</I> requests in flight, so that the throughput is not limited to one query per round trip.
+     *  Blocks until all answers have been delivered to the answer handler, which is called from within
+     *  the calling thread (i.e. it is allowed to block). A request that is not yet delivered counts as in
+     *  flight, so in the REQUEST_ORDER mode an outstanding answer also holds back the sending of further requests.
+     *  Member function is thread safe and reentrant.
+     *
+     *  @param first          the first request of the range
+     *  @param last           the end of the range
+     *  @param window         the maximal number of requests in flight (must be greater than zero)
+     *  @param answer_handler is called exactly once for each request, with its status code (see queryAsync)
+     *  @param order          the delivery order of the answers
+     *  @param timeout        the timeout of each individual request (see queryAsync)
+     *
+     *  @return status code:
+     *    - SMART_OK           : all answers (or the reason why a request has not been answered) have been delivered
+     *    - SMART_DISCONNECTED : the client is not connected to a server (the answer handler has not been called)
+     *    - SMART_ERROR        : the window is zero
+     */
+    template <class RequestIterator>
+    Smart::StatusCode queryPipelined(
+    		RequestIterator first,
+    		RequestIterator last,
+    		const size_t &window,
+    		const PipelineAnswerHandler &answer_handler,
+    		const QueryPipelineOrder &order = QueryPipelineOrder::COMPLETION_ORDER,
+    		const Smart::Duration &timeout = Smart::Duration::max())
+    {
+    	if(window == 0)
+    		return Smart::StatusCode::SMART_ERROR;
+    	if(disconnected_guard.trigger_value() == true)
+    		return Smart::StatusCode::SMART_DISCONNECTED;
+
+    	struct Completion {
+    		size_t request_index;
+    		Smart::StatusCode status;
+    		AnswerType answer;
+    	};
+    	// the answer callbacks only enqueue the completions which are then delivered by the calling thread
+    	struct PipelineState {
+    		std::mutex completions_mutex;
+    		std::condition_variable completions_cond;
+    		std::deque<Completion> completions;
+    	};
+    	auto state = std::make_shared<PipelineState>();
+    	auto enqueue = [state](const size_t &request_index, const Smart::StatusCode &status, const AnswerType &answer) {
+    		std::unique_lock<std::mutex> completions_lock(state->completions_mutex);
+    		state->completions.push_back(Completion{request_index, status, answer});
+    		completions_lock.unlock();
+    		state->completions_cond.notify_one();
+    	};
+
+    	// the reorder buffer of the REQUEST_ORDER mode (the undelivered requests always fit into one window)
+    	std::vector<Completion> reorder_slots;
+    	std::vector<bool> reorder_ready;
+    	if(order == QueryPipelineOrder::REQUEST_ORDER) {
+    		reorder_slots.resize(window);
+    		reorder_ready.resize(window, false);
+    	}
+
+    	size_t next_request_index = 0;
+    	size_t next_delivery_index = 0;
+    	size_t in_flight = 0;
+
+    	std::deque<Completion> received;
+    	while(true) {
+    		// fill up the window
+    		while(first != last && in_flight < window) {
+    			auto request_index = next_request_index++;
+    			auto status = this->queryAsync(*first, [enqueue, request_index](const Smart::StatusCode &status, const AnswerType &answer) {
+    				enqueue(request_index, status, answer);
+    			}, timeout);
+    			if(status != Smart::StatusCode::SMART_OK) {
+    				// the request has not been sent, so its callback will not be called
+    				enqueue(request_index, status, AnswerType());
+    			}
+    			++first;
+    			++in_flight;
+    		}
+    		if(in_flight == 0) {
+    			break;
+    		}
+
+    		// wait for (at least) the next completion
+    		{
+    			std::unique_lock<std::mutex> completions_lock(state->completions_mutex);
+    			state->completions_cond.wait(completions_lock, [&state]() { return !state->completions.empty(); });
+    			received.swap(state->completions);
+    		}
+
+    		for(auto &completion: received) {
+    			if(order == QueryPipelineOrder::COMPLETION_ORDER) {
+    				answer_handler(completion.request_index, completion.status, completion.answer);
+    				--in_flight;
+    			} else {
+    				auto slot = completion.request_index % window;
+    				reorder_slots[slot] = std::move(completion);
+    				reorder_ready[slot] = true;
+    				// deliver all consecutive answers
+    				for(slot = next_delivery_index % window; reorder_ready[slot]; slot = next_delivery_index % window) {
+    					reorder_ready[slot] = false;
+    					answer_handler(next_delivery_index, reorder_slots[slot].status, reorder_slots[slot].answer);
+    					++next_delivery_index;
+    					--in_flight;
+    				}
+    			}
+    		}
+    		received.clear();
+    	}
+
+    	return Smart::StatusCode::SMART_OK;
+    }
+
+    /** returns the statistics of the measured samples of the writer (only collected if a
+     *  sampling period is configured within the writer memory settings of the pattern QoS)
+     */
+    DDSWriterMemoryStatistics getWriterMemoryStatistics() const
+    {
+    	return dds_writer_connector.getMemoryStatistics();
+    }
 };
 
 } /* namespace SmartDDS */
@@ -45,6 +45,8 @@
 
 #include <dds/dds.hpp>
 
+#include "RTI-DDS-SmartSoft/DDSWriterMemorySettings.h"
+
 namespace SmartDDS {
 
 class QueryPatternQoS {
@@ -92,6 +94,16 @@ public:
 		topic_qos << dds::core::policy::Liveliness::Automatic();
 		return topic_qos;
 	}
+
+	static DDSWriterMemorySettings getRequestWriterMemorySettings() {
+		// samples up to 32 KB are served from the writer's pre-allocated pool (larger samples are allocated on demand)
+		return DDSWriterMemorySettings(32768);
+	}
+
+	static DDSWriterMemorySettings getReplyWriterMemorySettings() {
+		// samples up to 32 KB are served from the writer's pre-allocated pool (larger samples are allocated on demand)
+		return DDSWriterMemorySettings(32768);
+	}
 };
 
 } /* namespace SmartDDS */
@@ -43,17 +43,20 @@
 #ifndef RTIDDSSMARTSOFT_QUERYSERVERPATTERN_H_
 #define RTIDDSSMARTSOFT_QUERYSERVERPATTERN_H_
 
-#include <set>
-#include <list>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
 
 #include "RTI-DDS-SmartSoft/Component.h"
 #include "RTI-DDS-SmartSoft/CorrelationId.h"
+#include "RTI-DDS-SmartSoft/CorrelationTable.h"
 #include "RTI-DDS-SmartSoft/QueryPatternQoS.h"
 #include "RTI-DDS-SmartSoft/QueryServerHandler.h"
 
 #include "RTI-DDS-SmartSoft/DDSReaderConnector.h"
 #include "RTI-DDS-SmartSoft/DDSWriterConnector.h"
+#include "RTI-DDS-SmartSoft/DDSTypeTraits.h"
+#include "RTI-DDS-SmartSoft/LocalQueryService.h"
 
 #include <smartIQueryServerPattern_T.h>
 
@@ -62,45 +65,72 @@ namespace SmartDDS {
 template<class RequestType, class AnswerType>
 class QueryServerPattern
 :	public Smart::IQueryServerPattern<RequestType,AnswerType>
-,	public DynamicDataReaderListener
+,	public DDSReaderListener<typename DDSTypeTraits<RequestType>::SampleType>
+,	public LocalQueryHandler<RequestType, AnswerType>
 {
 private:
+	using RequestTraits = DDSTypeTraits<RequestType>;
+	using RequestSampleType = typename RequestTraits::SampleType;
+	using AnswerTraits = DDSTypeTraits<AnswerType>;
+	using AnswerSampleType = typename AnswerTraits::SampleType;
+
 	Component* component;
 
-	std::mutex server_mutex;
-	std::set<Smart::QueryIdPtr> request_cache;
-	std::list<dds::core::InstanceHandle> connected_clients;
+	// the pending requests (hashed by their raw correlation identity, see CorrelationTable) are not protected by
+	// the server mutex, which only protects the connected clients and the (re-)setting of the DDS entities
+	CorrelationTable<bool> request_cache;
+	std::shared_timed_mutex server_mutex;
+	std::unordered_set<dds::core::InstanceHandle, InstanceHandleHash> connected_clients;
+
+	DDSReaderConnector<RequestSampleType> dds_reader_connector;
+	DDSWriterConnector<AnswerSampleType> dds_writer_connector;
+
+	DDSTopic<RequestSampleType> dds_request_topic;
+	DDSReader<RequestSampleType> dds_request_reader;
+
+	DDSTopic<AnswerSampleType> dds_reply_topic;
+	DDSWriter<AnswerSampleType> dds_reply_writer;
 
-	DDSReaderConnector dds_reader_connector;
-	DDSWriterConnector dds_writer_connector;
+	// the in-process delivery path for clients within the same process (see LocalServiceRegistry)
+	LocalServiceRegistry::ServiceKey local_service_key;
+	std::shared_ptr<LocalQueryService<RequestType, AnswerType>> local_service;
+	CorrelationTable<std::shared_ptr<QueryClientAnswerTrigger<AnswerType>>> local_requests;
 
-	DynamicDataTopic dds_request_topic;
-	DynamicDataReader dds_request_reader;
+	virtual void handleLocalQuery(
+			const std::shared_ptr<CorrelationId> &query_id,
+			const RequestType &request,
+			const std::shared_ptr<QueryClientAnswerTrigger<AnswerType>> &answer_trigger) override
+	{
+		if(this->is_shutting_down()) {
+			answer_trigger->triggerDiscard();
+			return;
+		}
 
-	DynamicDataTopic dds_reply_topic;
-	DynamicDataWriter dds_reply_writer;
+		// the answer-trigger is used later within the answer method (instead of the reply writer)
+		local_requests.insert(query_id->getKey(), answer_trigger);
+
+		// propagate handle query request to the base class (which internally uses the registered handler)
+		IQueryServerBase::handleQuery(query_id, request);
+	}
 
     virtual void on_liveliness_changed(
-    	DynamicDataReader &reader,
+    	DDSReader<RequestSampleType> &reader,
         const LivelinessChangedStatus &status) override
     {
     	if(this->is_shutting_down())
     				return;
 
-    	std::unique_lock<std::mutex> lock(server_mutex);
+    	std::unique_lock<std::shared_timed_mutex> lock(server_mutex);
 
     	auto client_handle = status.last_publication_handle();
     	if(status.alive_count_change() > 0) {
-    		auto clientIt = std::find(connected_clients.cbegin(), connected_clients.cend(), client_handle);
-    		if(clientIt == connected_clients.end()) {
-    			connected_clients.push_back(client_handle);
-    		}
+    		connected_clients.insert(client_handle);
     	} else if(status.alive_count_change() < 0) {
-    		connected_clients.remove(client_handle);
+    		connected_clients.erase(client_handle);
     	}
     }
 
-	virtual void on_data_available(DynamicDataReader& reader) override
+	virtual void on_data_available(DDSReader<RequestSampleType>& reader) override
 	{
 		if(this->is_shutting_down())
 			return;
@@ -113,16 +143,13 @@ private:
 			{
 				RequestType request_object;
 				// convert the request data into the user-level object
-				convert(request.data(), request_object);
+				RequestTraits::fromSample(request.data(), request_object);
 				// get the original sample identity (aka QueryId) from the request info object
 				auto query_id = std::make_shared<CorrelationId>(request.info());
 
-				std::unique_lock<std::mutex> lock(server_mutex);
 				// we additionally store the request id inside an internal request cache for
 				// later validation within the answer method
-				request_cache.insert(query_id);
-				// release the lock before calling notify to ensure responsiveness of the pattern
-				lock.unlock();
+				request_cache.insert(query_id->getKey(), true);
 
 				// propagate handle query request to the base class (which internally uses the registered handler)
 				IQueryServerBase::handleQuery(query_id, request_object);
@@ -135,6 +162,15 @@ private:
 	}
 
 
+	// the query remains pending (as before a failed answer), unless the server has been shut down in the meantime
+	void restore_pending_request(const CorrelationKey &query_key)
+	{
+		std::shared_lock<std::shared_timed_mutex> lock(server_mutex);
+		if(!dds_reply_writer.is_nil()) {
+			request_cache.insert(query_key, true);
+		}
+	}
+
 	/** implements server-initiated-disconnect (SID)
 	 *
 	 *	The server-initiated-disconnect is specific to a certain server implementation.
@@ -145,8 +181,15 @@ private:
 	 */
 	virtual void serverInitiatedDisconnect() override
 	{
-		std::unique_lock<std::mutex> lock(server_mutex);
-		request_cache.clear();
+		local_service->deactivate();
+		LocalServiceRegistry::instance().unregisterService(local_service_key, local_service);
+
+		for(const auto &answer_trigger: local_requests.takeAll()) {
+			answer_trigger->triggerDiscard();
+		}
+		// the pending requests are dropped under the lock, so failed answers can not re-insert them afterwards (see answer())
+		std::unique_lock<std::shared_timed_mutex> lock(server_mutex);
+		request_cache.takeAll();
 		connected_clients.clear();
 		dds_reader_connector.reset(dds_request_reader);
 		component->DDS().resetTopic(dds_request_topic);
@@ -161,7 +204,7 @@ public:
 	:	IQueryServerBase(component, serviceName, query_handler)
 	,	component(component)
 	,	dds_reader_connector(component, QueryPatternQoS::getRequestTopicQoS())
-	,	dds_writer_connector(component, QueryPatternQoS::getReplyTopicQoS())
+	,	dds_writer_connector(component, QueryPatternQoS::getReplyTopicQoS(), QueryPatternQoS::getReplyWriterMemorySettings())
 	,	dds_request_topic(nullptr)
 	,	dds_request_reader(nullptr)
 	,	dds_reply_topic(nullptr)
@@ -170,16 +213,19 @@ public:
 		auto requestTopicName = component->getName()+"::"+serviceName+"::RequestTopic";
 		auto replyTopicName = component->getName()+"::"+serviceName+"::ReplyTopic";
 
-		// the dynamic DDS types are determined using external template methods
-		auto dds_request_type = dds_type<RequestType>();
-		auto dds_answer_type = dds_type<AnswerType>();
+		// create the two topics (the DDS types are determined by the DDSTypeTraits, i.e. either DynamicData or an IDL-generated type)
+		dds_request_topic = RequestTraits::findOrCreateTopic(component->DDS(), requestTopicName);
+		dds_reply_topic = AnswerTraits::findOrCreateTopic(component->DDS(), replyTopicName);
 
-		// create the two topics
-		dds_request_topic = component->DDS().findOrCreateTopic(requestTopicName, dds_request_type);
-		dds_reply_topic = component->DDS().findOrCreateTopic(replyTopicName, dds_answer_type);
+		dds_reader_connector.setQosProfile(DDSQosProfiles::findReaderProfile("QueryPattern", component->getName(), component->getName(), serviceName));
+		dds_writer_connector.setQosProfile(DDSQosProfiles::findWriterProfile("QueryPattern", component->getName(), component->getName(), serviceName));
 
 		dds_request_reader = dds_reader_connector.create_new_reader(dds_request_topic, this);
 		dds_reply_writer = dds_writer_connector.create_new_writer(dds_reply_topic);
+
+		local_service_key = LocalServiceRegistry::ServiceKey(component->DDS().getDomainId(), "QueryService::"+component->getName()+"::"+serviceName);
+		local_service = std::make_shared<LocalQueryService<RequestType, AnswerType>>(component->getLocalDispatcherPool(), this);
+		LocalServiceRegistry::instance().registerService(local_service_key, local_service);
 	}
 	virtual ~QueryServerPattern()
 	{
@@ -206,46 +252,62 @@ public:
 		if(this->is_shutting_down())
 			return Smart::StatusCode::SMART_DISCONNECTED;
 
-		// we uniquely lock the mutex for the entire method as the whole execution
-		// here should be comparably fast
-		std::unique_lock<std::mutex> lock(server_mutex);
-
-		// 1. check if the provided QueryId is valid
-		auto foundRequestId = request_cache.find(id);
-		if (foundRequestId == request_cache.end()) {
-			return Smart::StatusCode::SMART_WRONGID;
-		}
 		// here we downcast our shared pointer to the dds pointer type
 		auto dds_id = std::dynamic_pointer_cast<CorrelationId>(id);
 		if(!dds_id) {
-			// this case should never happen, but just in case...
+			return Smart::StatusCode::SMART_WRONGID;
+		}
+		auto query_key = dds_id->getKey();
+
+		// 0. queries of local clients are directly answered through their answer-trigger
+		std::shared_ptr<QueryClientAnswerTrigger<AnswerType>> answer_trigger;
+		if(local_requests.take(query_key, answer_trigger)) {
+			answer_trigger->triggerNewAnswer(answer);
+			return Smart::StatusCode::SMART_OK;
+		}
+
+		// 1. check if the provided QueryId is valid (the entry is taken, so concurrent answers for the same id are rejected)
+		bool pending = false;
+		if(!request_cache.take(query_key, pending)) {
 			return Smart::StatusCode::SMART_WRONGID;
 		}
 
-		// 2. check if related client still is connected
-		auto clientIt = std::find(connected_clients.cbegin(),
-				connected_clients.cend(), dds_id->getWriterHandle());
-		if (clientIt == connected_clients.end()) {
+		// 2. check if related client still is connected (and get the current reply writer)
+		std::shared_lock<std::shared_timed_mutex> lock(server_mutex);
+		if(connected_clients.find(dds_id->getWriterHandle()) == connected_clients.end()) {
+			lock.unlock();
+			restore_pending_request(query_key);
 			return Smart::StatusCode::SMART_DISCONNECTED;
 		}
+		auto reply_writer = dds_reply_writer;
+		lock.unlock();
 
+		// the answer is written outside of the lock, so concurrent answers (e.g. from a WorkStealingQueryHandler) do not serialize here
 		try {
 			rti::pub::WriteParams params;
 			// 3. set the related query ID as related sample ID
 			params.related_sample_identity(*dds_id);
 
 			// 4. send the actual answer along with the related query ID
-			dds_reply_writer->write(serialize(answer), params);
-
-			// 5. clean-up the cache
-			request_cache.erase(foundRequestId);
+			auto answer_sample = AnswerTraits::toSample(answer);
+			reply_writer->write(answer_sample, params);
+			dds_writer_connector.observe(answer_sample);
 		} catch (std::exception &ex) {
 			std::cerr << ex.what() << std::endl;
+			restore_pending_request(query_key);
 			return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
 		}
 		// all error cases have been checked and passed, so answer was successful
 		return Smart::StatusCode::SMART_OK;
     }
+
+    /** returns the statistics of the measured samples of the writer (only collected if a
+     *  sampling period is configured within the writer memory settings of the pattern QoS)
+     */
+    DDSWriterMemoryStatistics getWriterMemoryStatistics() const
+    {
+    	return dds_writer_connector.getMemoryStatistics();
+    }
 };
 
 } /* namespace SmartDDS */
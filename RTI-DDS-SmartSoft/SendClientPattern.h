@@ -44,35 +44,57 @@
 #define RTIDDSSMARTSOFT_SENDCLIENTPATTERN_H_
 
 #include "RTI-DDS-SmartSoft/Component.h"
+#include "RTI-DDS-SmartSoft/AsyncConnector.h"
 #include "RTI-DDS-SmartSoft/SendPatternQoS.h"
 
 #include "RTI-DDS-SmartSoft/DDSAliases.h"
+#include "RTI-DDS-SmartSoft/DDSTypeTraits.h"
+#include "RTI-DDS-SmartSoft/DDSSamplePool.h"
+#include "RTI-DDS-SmartSoft/LocalSendService.h"
 #include "RTI-DDS-SmartSoft/DDSWriterConnector.h"
 
 #include <smartISendClientPattern_T.h>
 
 #include <mutex>
+#include <future>
 
 namespace SmartDDS {
 
 template <class DataType>
 class SendClientPattern
 :	public Smart::ISendClientPattern<DataType>
-,	public DynamicDataWriterListener
+,	public DDSWriterListener<typename DDSTypeTraits<DataType>::SampleType>
+,	public LocalServiceClient
 {
 private:
+	using TypeTraits = DDSTypeTraits<DataType>;
+	using SampleType = typename TypeTraits::SampleType;
+
 	Component *component;
 
-	DynamicDataTopic dds_topic;
-	DynamicDataWriter dds_writer;
+	DDSTopic<SampleType> dds_topic;
+	DDSWriter<SampleType> dds_writer;
+
+	DDSWriterConnector<SampleType> dds_writer_connector;
 
-	DDSWriterConnector dds_writer_connector;
+	// reuses the writer samples so that steady-state sending does not allocate
+	DDSSamplePool<DataType> sample_pool;
 
 	std::recursive_mutex connection_mutex;
+	// the background connect of connectAsync(...), which is completed before disconnecting
+	AsyncConnector async_connector;
 	dds::core::cond::GuardCondition connection_guard;
 	dds::core::cond::GuardCondition nonblocking_guard;
 
-    virtual void on_publication_matched(DynamicDataWriter&, const PublicationMatchedStatus &status) override
+	// the in-process delivery path is used if the server lives in the same process (see LocalServiceRegistry)
+	std::shared_ptr<LocalSendService<DataType>> local_service;
+
+	virtual void onLocalServiceDisconnect() override
+	{
+		connection_guard.trigger_value(false);
+	}
+
+    virtual void on_publication_matched(DDSWriter<SampleType>&, const PublicationMatchedStatus &status) override
     {
     	if(status.current_count() == 0) {
     		connection_guard.trigger_value(false);
@@ -86,14 +108,14 @@ public:
 	,	component(component)
 	,	dds_topic(nullptr)
 	,	dds_writer(nullptr)
-	,	dds_writer_connector(component, SendPatternQoS::getTopicQoS())
+	,	dds_writer_connector(component, SendPatternQoS::getTopicQoS(), SendPatternQoS::getWriterMemorySettings())
 	{   }
 	SendClientPattern(Component* component, const std::string& server, const std::string& service)
 	:	Smart::ISendClientPattern<DataType>(component, server, service)
 	,	component(component)
 	,	dds_topic(nullptr)
 	,	dds_writer(nullptr)
-	,	dds_writer_connector(component, SendPatternQoS::getTopicQoS())
+	,	dds_writer_connector(component, SendPatternQoS::getTopicQoS(), SendPatternQoS::getWriterMemorySettings())
 	{
 		// this constructor performs an implicit connection
 		this->connect(server, service);
@@ -129,6 +151,9 @@ public:
      */
     virtual Smart::StatusCode connect(const std::string& server, const std::string& service) override
     {
+    	// a pending connectAsync(...) is completed first (it holds the connection mutex while connecting)
+    	async_connector.wait();
+
     	std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
 
     	// we by default disconnect the previous connection
@@ -140,11 +165,20 @@ public:
     	try {
 			// the topic-name is constructed from the component-instance-name and a server-port-name
 			std::string topicName = server+"::"+service;
-			// the dynamic type is determined from an externally implemented template method dds_type()
-			auto dynamic_type = dds_type<DataType>();
-			dds_topic = component->DDS().findOrCreateTopic(topicName, dynamic_type);
 
-			auto timeout = std::chrono::seconds(1);
+			// a server within the same process is connected directly (bypassing DDS)
+			local_service = LocalServiceRegistry::instance().findService<LocalSendService<DataType>>(
+					LocalServiceRegistry::ServiceKey(component->DDS().getDomainId(), "SendService::"+topicName));
+			if(local_service && local_service->attach(this)) {
+				connection_guard.trigger_value(true);
+				return Smart::StatusCode::SMART_OK;
+			}
+			local_service = nullptr;
+			// the topic type is determined by the DDSTypeTraits (either DynamicData or an IDL-generated type)
+			dds_topic = TypeTraits::findOrCreateTopic(component->DDS(), topicName);
+
+			dds_writer_connector.setQosProfile(DDSQosProfiles::findWriterProfile("SendPattern", component->getName(), server, service));
+			auto timeout = component->getConnectionTimeout();
 			auto connection_status = dds_writer_connector.reconnect(dds_writer, dds_topic, timeout, this);
 			if(connection_status != Smart::StatusCode::SMART_OK) {
 				this->disconnect();
@@ -162,6 +196,27 @@ public:
 		return Smart::StatusCode::SMART_ERROR;
     }
 
+    /** Asynchronously connect this service requestor to the denoted service provider.
+     *
+     *  This method returns immediately and performs the connect(server, service) call in the
+     *  background. This allows all client ports of a component to establish their connections
+     *  in parallel (instead of one after another) and to collect the results afterwards.
+     *  The maximal waiting time of each connection attempt is configured by the component
+     *  (see Component::setConnectionTimeout). A pending background connect is completed
+     *  before disconnect() proceeds (which also applies to the destructor).
+     *
+     * @param server     name of the server (i.e. the component-name to connect to)
+     * @param service    name of the service (i.e. the port-name of the component to connect to)
+     *
+     * @return a future providing the status code of the connect(server, service) call
+     */
+    std::future<Smart::StatusCode> connectAsync(const std::string& server, const std::string& service)
+    {
+    	return async_connector.start([this, server, service]() {
+    		return this->connect(server, service);
+    	});
+    }
+
     /** Disconnect the service requestor from the service provider.
      *
      *  It is no problem to change the connection to a service provider at any
@@ -178,8 +233,15 @@ public:
      */
     virtual Smart::StatusCode disconnect() override
     {
+    	// a pending connectAsync(...) is completed first (the connection is then closed below)
+    	async_connector.wait();
+
     	std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
 
+    	if(local_service) {
+    		local_service->detach(this);
+    		local_service = nullptr;
+    	}
     	dds_writer_connector.reset(dds_writer);
     	component->DDS().resetTopic(dds_topic);
 
@@ -207,6 +269,50 @@ public:
     	return Smart::StatusCode::SMART_OK;
     }
 
+    /** Configures the optional writer-side batching for high-rate small data (disabled by default).
+     *
+     *  The settings take effect with the next connect(server, service).
+     */
+    void setBatching(const DDSBatchSettings &batching)
+    {
+    	std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
+    	dds_writer_connector.setBatching(batching);
+    }
+
+    /** returns the statistics of the measured samples of the writer (only collected if a
+     *  sampling period is configured within the writer memory settings of the pattern QoS)
+     */
+    DDSWriterMemoryStatistics getWriterMemoryStatistics() const
+    {
+    	return dds_writer_connector.getMemoryStatistics();
+    }
+
+    /** Immediately sends all samples that are accumulated within the current batch
+     *  (only relevant if batching is enabled).
+     *
+     *  @return status code:
+     *    - SMART_OK                  : everything is ok
+     *    - SMART_DISCONNECTED        : the client is disconnected
+     *    - SMART_ERROR_COMMUNICATION : communication problems
+     */
+    Smart::StatusCode flush()
+    {
+    	std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
+    	if(local_service) {
+    		// the local path does not batch
+    		return Smart::StatusCode::SMART_OK;
+    	}
+    	try {
+    		if(dds_writer.is_nil())
+    			return Smart::StatusCode::SMART_DISCONNECTED;
+    		dds_writer->flush();
+    		return Smart::StatusCode::SMART_OK;
+    	} catch (std::exception &ex) {
+    		std::cerr << ex.what() << std::endl;
+    		return Smart::StatusCode::SMART_ERROR_COMMUNICATION;
+    	}
+    }
+
     /** Perform a one-way communication. Appropriate status codes make
      *  sure that the information has been transferred.
      *
@@ -226,10 +332,17 @@ public:
 
     	std::unique_lock<std::recursive_mutex> connection_lock(connection_mutex);
 
+    	if(local_service) {
+    		// the data is directly passed to the handler of the local server
+    		return local_service->send(data);
+    	}
+
 		// as long as no exceptions are thrown we assume that the communication was successful
    		try {
-   			// send the data sample
-			dds_writer.write(serialize(data));
+   			// send the data sample (the pooled sample is given back after the write)
+   			auto sample = sample_pool.acquire(data);
+			dds_writer.write(*sample);
+			dds_writer_connector.observe(*sample);
 			return Smart::StatusCode::SMART_OK;
 		} catch (std::exception &ex) {
 			std::cerr << ex.what() << std::endl;
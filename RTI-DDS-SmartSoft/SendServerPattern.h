@@ -48,6 +48,8 @@
 #include "RTI-DDS-SmartSoft/Component.h"
 #include "RTI-DDS-SmartSoft/SendPatternQoS.h"
 #include "RTI-DDS-SmartSoft/DDSReaderConnector.h"
+#include "RTI-DDS-SmartSoft/DDSTypeTraits.h"
+#include "RTI-DDS-SmartSoft/LocalSendService.h"
 
 #include <smartISendServerPattern_T.h>
 
@@ -56,8 +58,11 @@ namespace SmartDDS {
 template <class DataType>
 class SendServerPattern
 :	public Smart::ISendServerPattern<DataType>
-,	public DynamicDataReaderListener
+,	public DDSReaderListener<typename DDSTypeTraits<DataType>::SampleType>
+,	public LocalSendHandler<DataType>
 {
+	using TypeTraits = DDSTypeTraits<DataType>;
+	using SampleType = typename TypeTraits::SampleType;
 public:
 	using ISendServerBase = Smart::ISendServerPattern<DataType>;
 	using typename ISendServerBase::ISendServerHandlerPtr;
@@ -70,10 +75,13 @@ public:
 	,	dds_reader_connector(component, SendPatternQoS::getTopicQoS())
 	{
 		auto topicName = component->getName()+"::"+serviceName;
-		auto dds_dynamic_type = dds_type<DataType>();
-
-		dds_topic = component->DDS().findOrCreateTopic(topicName, dds_dynamic_type);
+		dds_topic = TypeTraits::findOrCreateTopic(component->DDS(), topicName);
+		dds_reader_connector.setQosProfile(DDSQosProfiles::findReaderProfile("SendPattern", component->getName(), component->getName(), serviceName));
 		dds_reader = dds_reader_connector.create_new_reader(dds_topic, this);
+
+		local_service_key = LocalServiceRegistry::ServiceKey(component->DDS().getDomainId(), "SendService::"+topicName);
+		local_service = std::make_shared<LocalSendService<DataType>>(component->getLocalDispatcherPool(), this);
+		LocalServiceRegistry::instance().registerService(local_service_key, local_service);
 	}
 	virtual ~SendServerPattern()
 	{
@@ -82,9 +90,13 @@ public:
 
 private:
 	Component* component;
-	DynamicDataTopic dds_topic;
-	DynamicDataReader dds_reader;
-	DDSReaderConnector dds_reader_connector;
+	DDSTopic<SampleType> dds_topic;
+	DDSReader<SampleType> dds_reader;
+	DDSReaderConnector<SampleType> dds_reader_connector;
+
+	// the in-process delivery path for clients within the same process (see LocalServiceRegistry)
+	LocalServiceRegistry::ServiceKey local_service_key;
+	std::shared_ptr<LocalSendService<DataType>> local_service;
 
 	/** implements server-initiated-disconnect (SID)
 	 *
@@ -96,11 +108,21 @@ private:
 	 */
 	virtual void serverInitiatedDisconnect() override
 	{
+		local_service->deactivate();
+		LocalServiceRegistry::instance().unregisterService(local_service_key, local_service);
 		dds_reader_connector.reset(dds_reader);
 		component->DDS().resetTopic(dds_topic);
 	}
 
-	virtual void on_data_available(dds::sub::DataReader<dds::core::xtypes::DynamicData>& reader) override
+	virtual void handleLocalSend(const DataType &data) override
+	{
+		if(this->is_shutting_down())
+			return;
+		// propagate the actual handling to the registered handler (within the sender's thread)
+		ISendServerBase::handleSend(data);
+	}
+
+	virtual void on_data_available(DDSReader<SampleType>& reader) override
 	{
 		if(this->is_shutting_down())
 		    return;
@@ -110,7 +132,7 @@ private:
 		for(const auto& sample: samples) {
 			if(sample.info().valid()) {
 				DataType input;
-				convert(sample.data(), input);
+				TypeTraits::fromSample(sample.data(), input);
 
 				// propagate the actual handling to the registered handler
 				ISendServerBase::handleSend(input);
@@ -0,0 +1,291 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#ifndef RTIDDSSMARTSOFT_TIMEINDEXEDHISTORY_H_
+#define RTIDDSSMARTSOFT_TIMEINDEXEDHISTORY_H_
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <functional>
+
+namespace SmartDDS {
+
+/** A bounded ring buffer of pushed values, indexed by their source timestamps.
+ *
+ *  The values are kept in the order of their timestamps (values older than the newest
+ *  stored value are ignored), so lookups use a binary search over a contiguous array of
+ *  timestamps. Only the writer side is serialized by a mutex. The lookups run concurrently
+ *  with the writer without taking this mutex: each slot carries a sequence number that is
+ *  checked before and after reading, and a lookup is repeated if the writer has overwritten
+ *  a visited slot in the meantime. The values themselves are shared (not copied) using the
+ *  atomic shared_ptr functions, just like the latest value of the PushClientPattern.
+ */
+template <class DataType>
+class TimeIndexedHistory {
+public:
+	using TimePoint = std::chrono::system_clock::time_point;
+	using ValuePtr = std::shared_ptr<const DataType>;
+	/** computes the value at the relative position ratio (in [0,1]) between the values before and after */
+	using Interpolator = std::function<DataType(const DataType &before, const DataType &after, const double &ratio)>;
+
+private:
+	const uint64_t capacity;
+	const Interpolator interpolator;
+
+	// the sequence number of a slot is the index of its entry plus one (zero while the slot is written)
+	std::unique_ptr<std::atomic<uint64_t>[]> sequences;
+	std::unique_ptr<std::atomic<int64_t>[]> timestamps;
+	std::unique_ptr<ValuePtr[]> values;
+
+	// the valid entries are [first_index, next_index) restricted to the last capacity entries
+	std::atomic<uint64_t> first_index;
+	std::atomic<uint64_t> next_index;
+
+	std::mutex writer_mutex;
+
+	static int64_t to_nanoseconds(const TimePoint &time) {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+	}
+
+	void get_range(uint64_t &begin, uint64_t &end) const {
+		end = next_index.load(std::memory_order_acquire);
+		begin = first_index.load(std::memory_order_acquire);
+		if(end - begin > capacity) {
+			begin = end - capacity;
+		}
+	}
+
+	bool read_timestamp(const uint64_t &index, int64_t &timestamp) const {
+		auto slot = index % capacity;
+		if(sequences[slot].load(std::memory_order_acquire) != index+1)
+			return false;
+		timestamp = timestamps[slot].load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return sequences[slot].load(std::memory_order_relaxed) == index+1;
+	}
+
+	bool read_entry(const uint64_t &index, int64_t &timestamp, ValuePtr &value) const {
+		auto slot = index % capacity;
+		if(sequences[slot].load(std::memory_order_acquire) != index+1)
+			return false;
+		timestamp = timestamps[slot].load(std::memory_order_relaxed);
+		value = std::atomic_load(&values[slot]);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return sequences[slot].load(std::memory_order_relaxed) == index+1;
+	}
+
+	// the index of the first entry whose timestamp is greater than (or, if inclusive, equal to) the given time
+	bool search(const uint64_t &begin, const uint64_t &end, const int64_t &time, const bool &inclusive, uint64_t &result) const {
+		uint64_t low = begin;
+		uint64_t high = end;
+		while(low < high) {
+			auto middle = low + (high - low) / 2;
+			int64_t timestamp = 0;
+			if(!read_timestamp(middle, timestamp))
+				return false;
+			if(timestamp < time || (!inclusive && timestamp == time)) {
+				low = middle + 1;
+			} else {
+				high = middle;
+			}
+		}
+		result = low;
+		return true;
+	}
+
+public:
+	/** Constructor
+	 *
+	 * @param capacity      the maximal number of kept values (at least one)
+	 * @param interpolator  the optional interpolation between two values (without it, getAt returns the preceding value)
+	 */
+	TimeIndexedHistory(const size_t &capacity, const Interpolator &interpolator = nullptr)
+	:	capacity(capacity > 0 ? capacity : 1)
+	,	interpolator(interpolator)
+	,	sequences(new std::atomic<uint64_t>[this->capacity])
+	,	timestamps(new std::atomic<int64_t>[this->capacity])
+	,	values(new ValuePtr[this->capacity])
+	,	first_index(0)
+	,	next_index(0)
+	{
+		for(uint64_t slot=0; slot<this->capacity; ++slot) {
+			sequences[slot].store(0, std::memory_order_relaxed);
+			timestamps[slot].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	size_t getCapacity() const {
+		return capacity;
+	}
+
+	/** adds a new value (values older than the newest stored value are ignored)
+	 *
+	 * @return true if the value has been stored
+	 */
+	bool push(const TimePoint &time, const ValuePtr &value) {
+		std::unique_lock<std::mutex> writer_lock(writer_mutex);
+		auto timestamp = to_nanoseconds(time);
+		auto index = next_index.load(std::memory_order_relaxed);
+		if(index > first_index.load(std::memory_order_relaxed)) {
+			auto previous = timestamps[(index-1) % capacity].load(std::memory_order_relaxed);
+			if(timestamp < previous)
+				return false;
+		}
+		auto slot = index % capacity;
+		// invalidate the slot while it is overwritten
+		sequences[slot].store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		timestamps[slot].store(timestamp, std::memory_order_relaxed);
+		std::atomic_store(&values[slot], value);
+		sequences[slot].store(index+1, std::memory_order_release);
+		next_index.store(index+1, std::memory_order_release);
+		return true;
+	}
+
+	/** removes all values (e.g. after a new subscription) */
+	void clear() {
+		std::unique_lock<std::mutex> writer_lock(writer_mutex);
+		first_index.store(next_index.load(std::memory_order_relaxed), std::memory_order_release);
+		// concurrent lookups notice the invalidated slots and start over with the (now empty) range
+		for(uint64_t slot=0; slot<capacity; ++slot) {
+			sequences[slot].store(0, std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_release);
+		for(uint64_t slot=0; slot<capacity; ++slot) {
+			std::atomic_store(&values[slot], ValuePtr());
+		}
+	}
+
+	/** the value at the given time
+	 *
+	 *  If the time lies between two stored values, then these are interpolated (if an
+	 *  interpolator is set), otherwise the value before the given time is returned.
+	 *
+	 * @return false if the time is outside of the stored time range
+	 */
+	bool getAt(const TimePoint &time, DataType &value) const {
+		auto timestamp = to_nanoseconds(time);
+		while(true) {
+			uint64_t begin = 0, end = 0;
+			get_range(begin, end);
+			if(begin == end)
+				return false;
+
+			uint64_t after_index = 0;
+			if(!search(begin, end, timestamp, false, after_index))
+				continue;
+			if(after_index == begin)
+				return false;
+
+			int64_t before_time = 0;
+			ValuePtr before_value;
+			if(!read_entry(after_index-1, before_time, before_value))
+				continue;
+			if(before_time == timestamp) {
+				value = *before_value;
+				return true;
+			}
+			if(after_index == end)
+				return false;
+			if(!interpolator) {
+				value = *before_value;
+				return true;
+			}
+
+			int64_t after_time = 0;
+			ValuePtr after_value;
+			if(!read_entry(after_index, after_time, after_value))
+				continue;
+			auto ratio = static_cast<double>(timestamp - before_time) / static_cast<double>(after_time - before_time);
+			value = interpolator(*before_value, *after_value, ratio);
+			return true;
+		}
+	}
+
+	/** all values within the time range [start, stop] (ordered by their timestamps)
+	 *
+	 * @return false if there is no value within this time range
+	 */
+	bool getBetween(const TimePoint &start, const TimePoint &stop, std::vector<DataType> &result) const {
+		result.clear();
+		auto start_timestamp = to_nanoseconds(start);
+		auto stop_timestamp = to_nanoseconds(stop);
+		if(stop_timestamp < start_timestamp)
+			return false;
+
+		std::vector<ValuePtr> selected_values;
+		while(true) {
+			uint64_t begin = 0, end = 0;
+			get_range(begin, end);
+
+			uint64_t first = 0, last = 0;
+			if(!search(begin, end, start_timestamp, true, first) || !search(first, end, stop_timestamp, false, last))
+				continue;
+
+			bool consistent = true;
+			selected_values.clear();
+			selected_values.reserve(last - first);
+			for(auto index=first; index<last && consistent; ++index) {
+				int64_t timestamp = 0;
+				ValuePtr value;
+				consistent = read_entry(index, timestamp, value);
+				selected_values.push_back(value);
+			}
+			if(consistent)
+				break;
+		}
+
+		// the values are only copied once the whole range has been read consistently
+		result.reserve(selected_values.size());
+		for(const auto &value: selected_values) {
+			result.push_back(*value);
+		}
+		return !result.empty();
+	}
+};
+
+} /* namespace SmartDDS */
+
+#endif /* RTIDDSSMARTSOFT_TIMEINDEXEDHISTORY_H_ */
@@ -104,6 +104,11 @@ void TimerManagerThread::timerRunnable()
 				timer_events.erase(currentEventIterator);
 
 				auto timerEntry = timers[currentTimerId];
+				if(timerEntry.interval <= Smart::Duration::zero()) {
+					// a one-shot timer is completed with this activation, so we remove it already here which means
+					// that a concurrent cancelTimer call fails from now on (and the handler keeps the ownership of the act)
+					timers.erase(currentTimerId);
+				}
 
 				// The timerExpired handler method might block for some time, therefore we release the
 				// mutex in order for the timer manager to remain responsive. For instance, this allows
@@ -134,7 +134,7 @@ public:
      *                     (see Asynchronous Completion Token (ACT), POSA2).
      *                     owned by act. If act == nullptr, nothing is retrieved.
      *  @return 0 on success
-     *  @return -1 on error
+     *  @return -1 on error (this includes one-shot timers that already expired)
      */
 	virtual int cancelTimer(const TimerId& timer_id, const void **act=nullptr) override;
 
@@ -0,0 +1,157 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+// measures the time until a component with many client ports is connected, either by calling
+// connect() for one port after another or by calling connectAsync() for all ports at once
+// (both components run within this process, but they are connected through DDS)
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+
+#include "CommPose6d.h"
+#include "CommPose6dDDS.h"
+
+#include "RTI-DDS-SmartSoft/Component.h"
+#include "RTI-DDS-SmartSoft/LocalServiceRegistry.h"
+#include "RTI-DDS-SmartSoft/PushClientPattern.h"
+#include "RTI-DDS-SmartSoft/PushServerPattern.h"
+
+using CommExampleObjects::CommPose6d;
+using PushClient = SmartDDS::PushClientPattern<CommPose6d>;
+
+static std::string serviceName(const size_t &index)
+{
+	return "PoseService" + std::to_string(index);
+}
+
+// returns the milliseconds until all clients are connected (or a negative value if a connection failed)
+static double connectSequentially(std::vector<std::unique_ptr<PushClient>> &clients)
+{
+	auto start = std::chrono::steady_clock::now();
+	for(size_t i=0; i<clients.size(); ++i) {
+		if(clients[i]->connect("ConnectBenchmarkServer", serviceName(i)) != Smart::StatusCode::SMART_OK) {
+			return -1.0;
+		}
+	}
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count();
+}
+
+static double connectAsynchronously(std::vector<std::unique_ptr<PushClient>> &clients)
+{
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::future<Smart::StatusCode>> results;
+	for(size_t i=0; i<clients.size(); ++i) {
+		results.push_back(clients[i]->connectAsync("ConnectBenchmarkServer", serviceName(i)));
+	}
+	bool connected = true;
+	for(auto &result: results) {
+		connected = (result.get() == Smart::StatusCode::SMART_OK) && connected;
+	}
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	return connected ? elapsed.count() : -1.0;
+}
+
+static void disconnectAll(std::vector<std::unique_ptr<PushClient>> &clients)
+{
+	for(auto &client: clients) {
+		client->disconnect();
+	}
+}
+
+static void print(const std::string &name, const double &milliseconds)
+{
+	std::cout << std::setw(14) << name;
+	if(milliseconds < 0.0) {
+		std::cout << std::setw(12) << "failed" << std::endl;
+	} else {
+		std::cout << std::setw(12) << std::fixed << std::setprecision(1) << milliseconds << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	size_t services = 16;
+	if(argc > 1) {
+		services = std::stoul(argv[1]);
+	}
+	size_t rounds = 3;
+	if(argc > 2) {
+		rounds = std::stoul(argv[2]);
+	}
+	// the clients are connected through DDS (and not through the in-process short-cut)
+	SmartDDS::LocalServiceRegistry::instance().setEnabled(false);
+
+	SmartDDS::Component server_component("ConnectBenchmarkServer");
+	SmartDDS::Component client_component("ConnectBenchmarkClient");
+	// the timeout applies to each connect() of all client ports of the component
+	client_component.setConnectionTimeout(std::chrono::seconds(10));
+
+	std::vector<std::unique_ptr<SmartDDS::PushServerPattern<CommPose6d>>> servers;
+	std::vector<std::unique_ptr<PushClient>> clients;
+	for(size_t i=0; i<services; ++i) {
+		servers.emplace_back(new SmartDDS::PushServerPattern<CommPose6d>(&server_component, serviceName(i)));
+		clients.emplace_back(new PushClient(&client_component));
+	}
+
+	// the first connection waits for the discovery of the two participants, which is not measured
+	if(clients[0]->connect("ConnectBenchmarkServer", serviceName(0)) != Smart::StatusCode::SMART_OK) {
+		std::cerr << "could not connect to ConnectBenchmarkServer" << std::endl;
+		return 1;
+	}
+	clients[0]->disconnect();
+
+	std::cout << "ms until " << services << " client ports are connected" << std::endl;
+	std::cout << std::setw(14) << "connect" << std::setw(12) << "total" << std::endl;
+	for(size_t round=0; round<rounds; ++round) {
+		print("sequential", connectSequentially(clients));
+		disconnectAll(clients);
+		print("connectAsync", connectAsynchronously(clients));
+		disconnectAll(clients);
+	}
+	return 0;
+}
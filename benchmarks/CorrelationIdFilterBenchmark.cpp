@@ -0,0 +1,174 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+// measures the writer-side cost of the prescale evaluation of the CorrelationIdFilter as the
+// number of prescaled readers grows, compared with the previous evaluation that serialized
+// all readers (and all writing threads) on one lock
+
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <shared_mutex>
+
+#include "RTI-DDS-SmartSoft/CorrelationIdFilter.h"
+
+// gives access to the (otherwise middleware-driven) compile/evaluate/finalize steps of the filter
+class FilterUnderTest : public SmartDDS::CorrelationIdFilterBase {
+public:
+	using CorrelationIdFilterBase::compile_reader;
+	using CorrelationIdFilterBase::evaluate_reader;
+	using CorrelationIdFilterBase::finalize_reader;
+};
+
+// the previous evaluation (one lock for all readers)
+class LockedFilter {
+public:
+	struct ReaderData {
+		int64_t update_counter = 0;
+		int64_t prescale_factor = 0;
+	};
+private:
+	std::shared_timed_mutex writer_mutex;
+	std::list<ReaderData> readers;
+public:
+	ReaderData& compile(const int64_t &prescale_factor) {
+		std::unique_lock<std::shared_timed_mutex> writer_lock(writer_mutex);
+		readers.emplace_front();
+		readers.front().prescale_factor = prescale_factor;
+		return readers.front();
+	}
+	bool evaluate(ReaderData &reader_data) {
+		std::unique_lock<std::shared_timed_mutex> writer_lock(writer_mutex);
+		return (reader_data.update_counter++ % reader_data.prescale_factor) == 0;
+	}
+};
+
+// returns the average time (in nanoseconds) of evaluating one sample for all readers
+static double runLocked(const size_t &readers, const size_t &writers, const size_t &samples)
+{
+	LockedFilter filter;
+	std::vector<LockedFilter::ReaderData*> compiled;
+	for(size_t r=0; r<readers; ++r) {
+		compiled.push_back(&filter.compile(r%4+1));
+	}
+	std::atomic<size_t> passed(0);
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for(size_t w=0; w<writers; ++w) {
+		threads.emplace_back([&]() {
+			size_t local_passed = 0;
+			for(size_t s=0; s<samples; ++s) {
+				for(auto reader_data: compiled) {
+					if(filter.evaluate(*reader_data)) local_passed++;
+				}
+			}
+			passed += local_passed;
+		});
+	}
+	for(auto &thread: threads) {
+		thread.join();
+	}
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / samples;
+}
+
+static double runLockFree(const size_t &readers, const size_t &writers, const size_t &samples)
+{
+	FilterUnderTest filter;
+	rti::topic::FilterSampleInfo meta_data;
+	std::vector<SmartDDS::CompiledReaderData*> compiled;
+	for(size_t r=0; r<readers; ++r) {
+		dds::core::StringSeq parameters(1, std::to_string(r%4+1));
+		compiled.push_back(&filter.compile_reader(SmartDDS::ConnectionId().toString(), parameters, nullptr));
+	}
+	std::atomic<size_t> passed(0);
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for(size_t w=0; w<writers; ++w) {
+		threads.emplace_back([&]() {
+			size_t local_passed = 0;
+			for(size_t s=0; s<samples; ++s) {
+				for(auto reader_data: compiled) {
+					if(filter.evaluate_reader(*reader_data, meta_data)) local_passed++;
+				}
+			}
+			passed += local_passed;
+		});
+	}
+	for(auto &thread: threads) {
+		thread.join();
+	}
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	for(auto reader_data: compiled) {
+		filter.finalize_reader(*reader_data);
+	}
+	return elapsed.count() / samples;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t max_writers = std::min(4u, std::max(1u, std::thread::hardware_concurrency()));
+	if(argc > 1) {
+		max_writers = std::stoul(argv[1]);
+	}
+	const size_t samples = 200000;
+
+	std::cout << "ns per written sample for all readers (lower is better), " << samples << " samples per writing thread" << std::endl;
+	std::cout << std::setw(8) << "writers" << std::setw(9) << "readers"
+			<< std::setw(14) << "one lock" << std::setw(14) << "per reader" << std::setw(10) << "speedup" << std::endl;
+	for(size_t writers=1; writers<=max_writers; writers*=2) {
+		for(size_t readers=1; readers<=64; readers*=2) {
+			auto locked_time = runLocked(readers, writers, samples);
+			auto lock_free_time = runLockFree(readers, writers, samples);
+			std::cout << std::setw(8) << writers << std::setw(9) << readers
+					<< std::setw(14) << std::fixed << std::setprecision(1) << locked_time
+					<< std::setw(14) << lock_free_time
+					<< std::setw(9) << std::setprecision(2) << locked_time / lock_free_time << "x" << std::endl;
+		}
+	}
+	return 0;
+}
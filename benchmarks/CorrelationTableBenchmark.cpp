@@ -0,0 +1,175 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+// compares the CorrelationTable of the QueryClientPattern with the previously used
+// std::map<CorrelationId,...> behind one mutex, for a growing number of client threads
+// that each keep a given number of queries in flight (insert on request, find on answer,
+// take on receive)
+
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+
+#include "RTI-DDS-SmartSoft/CorrelationTable.h"
+
+using Trigger = std::shared_ptr<int>;
+
+class MapTable {
+private:
+	std::recursive_mutex table_mutex;
+	std::map<SmartDDS::CorrelationId, Trigger> table;
+public:
+	void insert(const SmartDDS::CorrelationId &id, const Trigger &value) {
+		std::unique_lock<std::recursive_mutex> lock(table_mutex);
+		table[id] = value;
+	}
+	bool find(const SmartDDS::CorrelationId &id, Trigger &value) {
+		std::unique_lock<std::recursive_mutex> lock(table_mutex);
+		auto it = table.find(id);
+		if(it == table.end())
+			return false;
+		value = it->second;
+		return true;
+	}
+	bool take(const SmartDDS::CorrelationId &id, Trigger &value) {
+		std::unique_lock<std::recursive_mutex> lock(table_mutex);
+		auto it = table.find(id);
+		if(it == table.end())
+			return false;
+		value = std::move(it->second);
+		table.erase(it);
+		return true;
+	}
+};
+
+class HashTable {
+private:
+	SmartDDS::CorrelationTable<Trigger> table;
+public:
+	void insert(const SmartDDS::CorrelationId &id, const Trigger &value) {
+		table.insert(id.getKey(), value);
+	}
+	bool find(const SmartDDS::CorrelationId &id, Trigger &value) {
+		return table.find(id.getKey(), value);
+	}
+	bool take(const SmartDDS::CorrelationId &id, Trigger &value) {
+		return table.take(id.getKey(), value);
+	}
+};
+
+static SmartDDS::CorrelationId createId(const size_t &client, const int64_t &sequence_number)
+{
+	rti::core::Guid guid;
+	for(size_t i=0; i<16; ++i) {
+		guid[i] = static_cast<uint8_t>((client * 31 + i * 7) & 0xff);
+	}
+	return SmartDDS::CorrelationId(rti::core::SampleIdentity(guid, rti::core::SequenceNumber(sequence_number)));
+}
+
+// returns the number of completed queries per second
+template <class Table>
+static double run(const size_t &threads, const size_t &in_flight, const size_t &queries_per_thread)
+{
+	Table table;
+	auto trigger = std::make_shared<int>(0);
+
+	// the ids are created up front, so only the table operations are measured
+	std::vector<std::vector<SmartDDS::CorrelationId>> ids(threads);
+	for(size_t t=0; t<threads; ++t) {
+		for(size_t q=0; q<queries_per_thread; ++q) {
+			ids[t].push_back(createId(t, q+1));
+		}
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> clients;
+	for(size_t t=0; t<threads; ++t) {
+		clients.emplace_back([&table, &trigger, &ids, t, in_flight, queries_per_thread]() {
+			Trigger value;
+			for(size_t q=0; q<queries_per_thread; ++q) {
+				table.insert(ids[t][q], trigger);
+				if(q >= in_flight) {
+					// the oldest query is answered and received
+					table.find(ids[t][q-in_flight], value);
+					table.take(ids[t][q-in_flight], value);
+				}
+			}
+			for(size_t q=queries_per_thread-std::min(in_flight,queries_per_thread); q<queries_per_thread; ++q) {
+				table.take(ids[t][q], value);
+			}
+		});
+	}
+	for(auto &client: clients) {
+		client.join();
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return (threads * queries_per_thread) / elapsed.count();
+}
+
+int main(int argc, char* argv[])
+{
+	size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+	if(argc > 1) {
+		max_threads = std::stoul(argv[1]);
+	}
+	const size_t queries_per_thread = 200000;
+
+	std::cout << "queries/s (higher is better), " << queries_per_thread << " queries per thread" << std::endl;
+	std::cout << std::setw(8) << "threads" << std::setw(11) << "in-flight"
+			<< std::setw(16) << "std::map" << std::setw(20) << "CorrelationTable" << std::setw(10) << "speedup" << std::endl;
+	for(size_t in_flight: {16, 1024, 16384}) {
+		for(size_t threads=1; threads<=max_threads; threads*=2) {
+			auto map_rate = run<MapTable>(threads, in_flight, queries_per_thread);
+			auto hash_rate = run<HashTable>(threads, in_flight, queries_per_thread);
+			std::cout << std::setw(8) << threads << std::setw(11) << in_flight
+					<< std::setw(16) << std::fixed << std::setprecision(0) << map_rate
+					<< std::setw(20) << hash_rate
+					<< std::setw(9) << std::setprecision(2) << hash_rate / map_rate << "x" << std::endl;
+		}
+	}
+	return 0;
+}
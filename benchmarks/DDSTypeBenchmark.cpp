@@ -0,0 +1,154 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+// compares the DynamicData and the IDL-generated (rtiddsgen) representation of the example
+// communication objects CommPose6d and CommTrajectory, by measuring the conversion of an object
+// into a sample, its CDR serialization (as done by the writer) and the way back (as done by the reader)
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+
+#include "CommPose6dDDS.h"
+#include "CommTrajectoryDDS.h"
+
+#include "RTI-DDS-SmartSoft/DDSTypeTraits.h"
+
+using CommExampleObjects::CommPose6d;
+using CommExampleObjects::CommTrajectory;
+
+// the DynamicData path (i.e. the global functions that the DynamicData DDSTypeTraits would use)
+template <class DataType>
+struct DynamicPath {
+	using SampleType = dds::core::xtypes::DynamicData;
+	static SampleType toSample(const DataType &object) {
+		return serialize(object);
+	}
+	static void fromSample(const SampleType &sample, DataType &object) {
+		convert(sample, object);
+	}
+	static SampleType createSample() {
+		return SampleType(SmartDDS::DDSTypeRegistry::get<DataType>());
+	}
+};
+
+// the IDL path (selected by the DDSIdlType specialization of the communication object)
+template <class DataType>
+struct IdlPath {
+	using Traits = SmartDDS::DDSTypeTraits<DataType>;
+	using SampleType = typename Traits::SampleType;
+	static SampleType toSample(const DataType &object) {
+		return Traits::toSample(object);
+	}
+	static void fromSample(const SampleType &sample, DataType &object) {
+		Traits::fromSample(sample, object);
+	}
+	static SampleType createSample() {
+		return Traits::createSample();
+	}
+};
+
+// returns the average time (in microseconds) of one round trip of an object
+template <class Path, class DataType>
+static double run(const DataType &object, const size_t &iterations)
+{
+	using SampleType = typename Path::SampleType;
+	std::vector<char> buffer;
+	auto received_sample = Path::createSample();
+	DataType received_object;
+
+	auto start = std::chrono::steady_clock::now();
+	for(size_t i=0; i<iterations; ++i) {
+		auto sample = Path::toSample(object);
+		dds::topic::topic_type_support<SampleType>::to_cdr_buffer(buffer, sample);
+		dds::topic::topic_type_support<SampleType>::from_cdr_buffer(received_sample, buffer);
+		Path::fromSample(received_sample, received_object);
+	}
+	std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / iterations;
+}
+
+template <class DataType>
+static void compare(const std::string &name, const DataType &object, const size_t &iterations)
+{
+	auto dynamic_time = run<DynamicPath<DataType>>(object, iterations);
+	auto idl_time = run<IdlPath<DataType>>(object, iterations);
+	std::cout << std::setw(24) << name
+			<< std::setw(16) << std::fixed << std::setprecision(2) << dynamic_time
+			<< std::setw(12) << idl_time
+			<< std::setw(9) << std::setprecision(1) << dynamic_time / idl_time << "x" << std::endl;
+}
+
+static CommPose6d createPose(const double &value)
+{
+	CommPose6d pose;
+	pose.position.x = value;
+	pose.position.y = value;
+	pose.position.z = value;
+	pose.orientation.pitch = value;
+	pose.orientation.yaw = value;
+	pose.orientation.roll = value;
+	return pose;
+}
+
+static CommTrajectory createTrajectory(const size_t &size)
+{
+	CommTrajectory trajectory;
+	trajectory.description = "benchmark trajectory";
+	for(size_t i=0; i<size; ++i) {
+		trajectory.poses.push_back(createPose(i));
+	}
+	return trajectory;
+}
+
+int main(int argc, char* argv[])
+{
+	std::cout << "us per object for serialize, to CDR, from CDR and convert (lower is better)" << std::endl;
+	std::cout << std::setw(24) << "object" << std::setw(16) << "DynamicData" << std::setw(12) << "IDL" << std::setw(10) << "speedup" << std::endl;
+	compare("CommPose6d", createPose(1.0), 100000);
+	compare("CommTrajectory(10)", createTrajectory(10), 10000);
+	compare("CommTrajectory(1000)", createTrajectory(1000), 200);
+	compare("CommTrajectory(10000)", createTrajectory(10000), 20);
+	return 0;
+}
@@ -0,0 +1,164 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+// measures the round trips per second of a QueryClientPattern, either by calling query() for one
+// request after another or by sending the same requests through queryPipelined() with a growing
+// window (both components run within this process, but they are connected through DDS)
+
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+
+#include "CommPose6d.h"
+#include "CommPose6dDDS.h"
+
+#include "RTI-DDS-SmartSoft/Component.h"
+#include "RTI-DDS-SmartSoft/LocalServiceRegistry.h"
+#include "RTI-DDS-SmartSoft/QueryClientPattern.h"
+#include "RTI-DDS-SmartSoft/QueryServerPattern.h"
+
+using CommExampleObjects::CommPosition;
+using CommExampleObjects::CommPose6d;
+using QueryClient = SmartDDS::QueryClientPattern<CommPosition,CommPose6d>;
+
+// answers each query immediately, so the measured time is dominated by the round trips
+class EchoHandler
+:	public SmartDDS::QueryServerHandler<CommPosition,CommPose6d>
+{
+private:
+	virtual void handleQuery(IQueryServer &server, const Smart::QueryIdPtr &id, const CommPosition& request) override
+	{
+		CommPose6d answer;
+		answer.position = request;
+		server.answer(id, answer);
+	}
+public:
+	virtual ~EchoHandler() = default;
+};
+
+// returns the queries per second (or a negative value if a query failed)
+static double querySequentially(QueryClient &client, const std::vector<CommPosition> &requests)
+{
+	CommPose6d answer;
+	auto start = std::chrono::steady_clock::now();
+	for(const auto &request: requests) {
+		if(client.query(request, answer) != Smart::StatusCode::SMART_OK) {
+			return -1.0;
+		}
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return requests.size() / elapsed.count();
+}
+
+static double queryPipelined(QueryClient &client, const std::vector<CommPosition> &requests, const size_t &window)
+{
+	size_t answered = 0;
+	auto answer_handler = [&answered](const size_t &request_index, const Smart::StatusCode &status, const CommPose6d &answer) {
+		if(status == Smart::StatusCode::SMART_OK) answered++;
+	};
+	auto start = std::chrono::steady_clock::now();
+	auto status = client.queryPipelined(requests.begin(), requests.end(), window, answer_handler,
+			SmartDDS::QueryPipelineOrder::COMPLETION_ORDER, std::chrono::seconds(60));
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	if(status != Smart::StatusCode::SMART_OK || answered != requests.size()) {
+		return -1.0;
+	}
+	return requests.size() / elapsed.count();
+}
+
+static void print(const std::string &name, const double &queries_per_second)
+{
+	std::cout << std::setw(14) << name;
+	if(queries_per_second < 0.0) {
+		std::cout << std::setw(14) << "failed" << std::endl;
+	} else {
+		std::cout << std::setw(14) << static_cast<size_t>(queries_per_second) << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	size_t queries = 2000;
+	if(argc > 1) {
+		queries = std::stoul(argv[1]);
+	}
+	size_t rounds = 3;
+	if(argc > 2) {
+		rounds = std::stoul(argv[2]);
+	}
+	// the client is connected through DDS (and not through the in-process short-cut)
+	SmartDDS::LocalServiceRegistry::instance().setEnabled(false);
+
+	SmartDDS::Component server_component("QueryPipelineBenchmarkServer");
+	SmartDDS::Component client_component("QueryPipelineBenchmarkClient");
+	SmartDDS::QueryServerPattern<CommPosition,CommPose6d> server(&server_component, "EchoService", std::make_shared<EchoHandler>());
+	QueryClient client(&client_component);
+	client_component.setConnectionTimeout(std::chrono::seconds(10));
+	if(client.connect("QueryPipelineBenchmarkServer", "EchoService") != Smart::StatusCode::SMART_OK) {
+		std::cerr << "could not connect to QueryPipelineBenchmarkServer" << std::endl;
+		return 1;
+	}
+
+	std::vector<CommPosition> requests(queries);
+	for(size_t i=0; i<requests.size(); ++i) {
+		requests[i].x = i;
+		requests[i].y = 0.5;
+		requests[i].z = 0.0;
+	}
+	// the first queries wait for the matching of the answer writer and reader, which is not measured
+	querySequentially(client, std::vector<CommPosition>(requests.begin(), requests.begin() + std::min<size_t>(queries, 10)));
+
+	std::cout << "queries/s of " << queries << " round trips" << std::endl;
+	std::cout << std::setw(14) << "query" << std::setw(14) << "rate" << std::endl;
+	for(size_t round=0; round<rounds; ++round) {
+		print("sequential", querySequentially(client, requests));
+		for(size_t window=1; window<=64; window*=4) {
+			print("window " + std::to_string(window), queryPipelined(client, requests, window));
+		}
+	}
+	client.disconnect();
+	return 0;
+}
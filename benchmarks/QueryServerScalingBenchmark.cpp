@@ -0,0 +1,115 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+// measures the throughput of the example QueryServer (see examples/example_query_server.cpp),
+// started with a number of workers for its WorkStealingQueryHandler, by sending a range of
+// queries through a pipelined QueryClientPattern (see run_query_server_scaling.sh)
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+#include "CommPose6d.h"
+#include "CommPose6dDDS.h"
+
+#include "RTI-DDS-SmartSoft/Component.h"
+#include "RTI-DDS-SmartSoft/QueryClientPattern.h"
+
+using CommExampleObjects::CommPosition;
+using CommExampleObjects::CommPose6d;
+
+int main(int argc, char* argv[])
+{
+	std::string serverName = "QueryServer";
+	if(argc > 1) {
+		serverName = argv[1];
+	}
+	size_t queries = 2000;
+	if(argc > 2) {
+		queries = std::stoul(argv[2]);
+	}
+	size_t window = 64;
+	if(argc > 3) {
+		window = std::stoul(argv[3]);
+	}
+	std::string serviceName = "TextService";
+
+	SmartDDS::Component component("QueryServerScalingBenchmark");
+	SmartDDS::QueryClientPattern<CommPosition,CommPose6d> client(&component);
+	// the server might still be starting up
+	auto status = client.connect(serverName, serviceName);
+	for(int retry=0; retry<50 && status != Smart::StatusCode::SMART_OK; ++retry) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		status = client.connect(serverName, serviceName);
+	}
+	if(status != Smart::StatusCode::SMART_OK) {
+		std::cerr << "could not connect to " << serverName << "::" << serviceName << " (" << status << ")" << std::endl;
+		return 1;
+	}
+
+	std::vector<CommPosition> requests(queries);
+	for(size_t i=0; i<requests.size(); ++i) {
+		requests[i].x = i;
+		requests[i].y = 0.5;
+		requests[i].z = 0.0;
+	}
+	size_t answered = 0;
+	auto answer_handler = [&answered](const size_t &request_index, const Smart::StatusCode &status, const CommPose6d &answer) {
+		if(status == Smart::StatusCode::SMART_OK) answered++;
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	status = client.queryPipelined(requests.begin(), requests.end(), window, answer_handler,
+			SmartDDS::QueryPipelineOrder::COMPLETION_ORDER, std::chrono::seconds(60));
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	client.disconnect();
+
+	if(status != Smart::StatusCode::SMART_OK || answered != queries) {
+		std::cerr << "only " << answered << " of " << queries << " queries were answered (" << status << ")" << std::endl;
+		return 1;
+	}
+	// prints only the rate, so the script can collect one value per run
+	std::cout << static_cast<size_t>(queries / elapsed.count()) << std::endl;
+	return 0;
+}
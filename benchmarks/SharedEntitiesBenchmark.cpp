@@ -0,0 +1,204 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+// counts the DDS entities and the resident memory of two components with many connected push and
+// query ports, which share one publisher and one subscriber per component, and compares them to the
+// former layout with a dedicated publisher per writer and a dedicated subscriber per reader (which
+// is rebuilt here by creating the additional publishers and subscribers on the same participants)
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+
+#include "CommPose6d.h"
+#include "CommPose6dDDS.h"
+
+#include "RTI-DDS-SmartSoft/Component.h"
+#include "RTI-DDS-SmartSoft/LocalServiceRegistry.h"
+#include "RTI-DDS-SmartSoft/PushClientPattern.h"
+#include "RTI-DDS-SmartSoft/PushServerPattern.h"
+#include "RTI-DDS-SmartSoft/QueryClientPattern.h"
+#include "RTI-DDS-SmartSoft/QueryServerPattern.h"
+
+using CommExampleObjects::CommPosition;
+using CommExampleObjects::CommPose6d;
+
+struct EntityCount {
+	size_t publishers = 0;
+	size_t subscribers = 0;
+	size_t writers = 0;
+	size_t readers = 0;
+};
+
+static EntityCount countEntities(const dds::domain::DomainParticipant &participant)
+{
+	EntityCount count;
+	std::vector<dds::pub::Publisher> publishers;
+	rti::pub::find_publishers(participant, std::back_inserter(publishers));
+	for(const auto &publisher: publishers) {
+		std::vector<dds::pub::AnyDataWriter> writers;
+		count.writers += rti::pub::find_datawriters(publisher, std::back_inserter(writers));
+	}
+	std::vector<dds::sub::Subscriber> subscribers;
+	rti::sub::find_subscribers(participant, std::back_inserter(subscribers));
+	for(const auto &subscriber: subscribers) {
+		std::vector<dds::sub::AnyDataReader> readers;
+		count.readers += rti::sub::find_datareaders(subscriber, std::back_inserter(readers));
+	}
+	count.publishers = publishers.size();
+	count.subscribers = subscribers.size();
+	return count;
+}
+
+// the resident set size of this process in kB (Linux only, 0 otherwise)
+static size_t residentKilobytes()
+{
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while(std::getline(status, line)) {
+		if(line.compare(0, 6, "VmRSS:") == 0) {
+			return std::stoul(line.substr(6));
+		}
+	}
+	return 0;
+}
+
+static void print(const std::string &name, const EntityCount &count, const size_t &rss)
+{
+	std::cout << std::setw(12) << name
+			<< std::setw(12) << count.publishers << std::setw(12) << count.subscribers
+			<< std::setw(10) << count.writers << std::setw(10) << count.readers
+			<< std::setw(12) << rss << std::endl;
+}
+
+static EntityCount operator+(const EntityCount &left, const EntityCount &right)
+{
+	EntityCount sum;
+	sum.publishers = left.publishers + right.publishers;
+	sum.subscribers = left.subscribers + right.subscribers;
+	sum.writers = left.writers + right.writers;
+	sum.readers = left.readers + right.readers;
+	return sum;
+}
+
+static std::string serviceName(const std::string &prefix, const size_t &index)
+{
+	return prefix + std::to_string(index);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t services = 16;
+	if(argc > 1) {
+		services = std::stoul(argv[1]);
+	}
+	// the clients are connected through DDS (and not through the in-process short-cut)
+	SmartDDS::LocalServiceRegistry::instance().setEnabled(false);
+
+	size_t initial_rss = residentKilobytes();
+	SmartDDS::Component server_component("SharedEntitiesBenchmarkServer");
+	SmartDDS::Component client_component("SharedEntitiesBenchmarkClient");
+	client_component.setConnectionTimeout(std::chrono::seconds(10));
+	auto &server_participant = server_component.DDS().getDomainParticipant();
+	auto &client_participant = client_component.DDS().getDomainParticipant();
+	size_t participants_rss = residentKilobytes();
+
+	std::vector<std::unique_ptr<SmartDDS::PushServerPattern<CommPose6d>>> push_servers;
+	std::vector<std::unique_ptr<SmartDDS::PushClientPattern<CommPose6d>>> push_clients;
+	std::vector<std::unique_ptr<SmartDDS::QueryServerPattern<CommPosition,CommPose6d>>> query_servers;
+	std::vector<std::unique_ptr<SmartDDS::QueryClientPattern<CommPosition,CommPose6d>>> query_clients;
+	for(size_t i=0; i<services; ++i) {
+		push_servers.emplace_back(new SmartDDS::PushServerPattern<CommPose6d>(&server_component, serviceName("PoseService", i)));
+		query_servers.emplace_back(new SmartDDS::QueryServerPattern<CommPosition,CommPose6d>(&server_component, serviceName("QueryService", i)));
+		push_clients.emplace_back(new SmartDDS::PushClientPattern<CommPose6d>(&client_component));
+		query_clients.emplace_back(new SmartDDS::QueryClientPattern<CommPosition,CommPose6d>(&client_component));
+		if(push_clients.back()->connect("SharedEntitiesBenchmarkServer", serviceName("PoseService", i)) != Smart::StatusCode::SMART_OK
+				|| query_clients.back()->connect("SharedEntitiesBenchmarkServer", serviceName("QueryService", i)) != Smart::StatusCode::SMART_OK)
+		{
+			std::cerr << "could not connect to SharedEntitiesBenchmarkServer" << std::endl;
+			return 1;
+		}
+	}
+	auto shared_count = countEntities(server_participant) + countEntities(client_participant);
+	size_t shared_rss = residentKilobytes();
+
+	// the former layout: one publisher per writer and one subscriber per reader (the already shared
+	// publisher and subscriber of each participant count for one writer and one reader)
+	std::vector<dds::pub::Publisher> dedicated_publishers;
+	std::vector<dds::sub::Subscriber> dedicated_subscribers;
+	for(auto participant: {server_participant, client_participant}) {
+		auto count = countEntities(participant);
+		for(size_t i=count.publishers; i<count.writers; ++i) {
+			dedicated_publishers.emplace_back(participant);
+		}
+		for(size_t i=count.subscribers; i<count.readers; ++i) {
+			dedicated_subscribers.emplace_back(participant);
+		}
+	}
+	auto dedicated_count = countEntities(server_participant) + countEntities(client_participant);
+	size_t dedicated_rss = residentKilobytes();
+
+	std::cout << "DDS entities of two components with " << services << " push and " << services << " query services" << std::endl;
+	std::cout << "(RSS in kB: " << initial_rss << " at start, " << participants_rss << " with the two participants)" << std::endl;
+	std::cout << std::setw(12) << "layout"
+			<< std::setw(12) << "publishers" << std::setw(12) << "subscribers"
+			<< std::setw(10) << "writers" << std::setw(10) << "readers"
+			<< std::setw(12) << "RSS kB" << std::endl;
+	print("shared", shared_count, shared_rss);
+	print("dedicated", dedicated_count, dedicated_rss);
+	std::cout << "the dedicated layout adds " << (dedicated_count.publishers - shared_count.publishers) << " publishers, "
+			<< (dedicated_count.subscribers - shared_count.subscribers) << " subscribers and "
+			<< (static_cast<long>(dedicated_rss) - static_cast<long>(shared_rss)) << " kB" << std::endl;
+
+	for(auto &client: push_clients) {
+		client->disconnect();
+	}
+	for(auto &client: query_clients) {
+		client->disconnect();
+	}
+	return 0;
+}
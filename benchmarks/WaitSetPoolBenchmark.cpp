@@ -0,0 +1,143 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+// measures the overhead of a blocking client call (e.g. PushClientPattern::getUpdateWait())
+// whose condition is already triggered, i.e. the WaitSet handling without any actual waiting:
+// a new WaitSet with all guards attached for each call (as before) compared with a WaitSet
+// borrowed from the DDSWaitSetPool, for a growing number of concurrently calling threads
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+
+#include "RTI-DDS-SmartSoft/DDSWaitSetPool.h"
+
+// the guards of a client pattern (the new-data guard is triggered, so each wait returns right away)
+struct ClientGuards {
+	dds::core::cond::GuardCondition new_data_guard;
+	dds::core::cond::GuardCondition disconnected_guard;
+	dds::core::cond::GuardCondition unsubscribed_guard;
+	dds::core::cond::GuardCondition nonblocking_guard;
+
+	ClientGuards() {
+		new_data_guard.trigger_value(true);
+	}
+};
+
+class NewWaitSetCall {
+private:
+	ClientGuards &guards;
+public:
+	NewWaitSetCall(ClientGuards &guards)
+	:	guards(guards)
+	{  }
+	bool call() {
+		dds::core::cond::WaitSet wait_set;
+		wait_set += guards.new_data_guard;
+		wait_set += guards.disconnected_guard;
+		wait_set += guards.unsubscribed_guard;
+		wait_set += guards.nonblocking_guard;
+		auto active_conditions = wait_set.wait(std::chrono::seconds(1));
+		return !active_conditions.empty();
+	}
+};
+
+class PooledWaitSetCall {
+private:
+	SmartDDS::DDSWaitSetPool wait_sets;
+public:
+	PooledWaitSetCall(ClientGuards &guards)
+	:	wait_sets({guards.new_data_guard, guards.disconnected_guard, guards.unsubscribed_guard, guards.nonblocking_guard})
+	{  }
+	bool call() {
+		auto wait_set = wait_sets.acquire();
+		return !wait_set.wait(std::chrono::seconds(1)).empty();
+	}
+};
+
+// returns the average nanoseconds per call (i.e. the time of one call as seen by each calling thread)
+template <class Call>
+static double run(const size_t &threads, const size_t &calls_per_thread)
+{
+	// all threads call the same client pattern
+	ClientGuards guards;
+	Call client_call(guards);
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> callers;
+	for(size_t t=0; t<threads; ++t) {
+		callers.emplace_back([&client_call, calls_per_thread]() {
+			for(size_t c=0; c<calls_per_thread; ++c) {
+				client_call.call();
+			}
+		});
+	}
+	for(auto &caller: callers) {
+		caller.join();
+	}
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / calls_per_thread;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+	if(argc > 1) {
+		max_threads = std::stoul(argv[1]);
+	}
+	const size_t calls_per_thread = 100000;
+
+	std::cout << "ns per blocking call (lower is better, the condition is already triggered), " << calls_per_thread << " calls per thread" << std::endl;
+	std::cout << std::setw(8) << "threads" << std::setw(14) << "new WaitSet" << std::setw(16) << "DDSWaitSetPool" << std::setw(10) << "speedup" << std::endl;
+	for(size_t threads=1; threads<=max_threads; threads*=2) {
+		auto new_ns = run<NewWaitSetCall>(threads, calls_per_thread);
+		auto pooled_ns = run<PooledWaitSetCall>(threads, calls_per_thread);
+		std::cout << std::setw(8) << threads
+				<< std::setw(14) << std::fixed << std::setprecision(0) << new_ns
+				<< std::setw(16) << pooled_ns
+				<< std::setw(9) << std::setprecision(2) << new_ns / pooled_ns << "x" << std::endl;
+	}
+	return 0;
+}
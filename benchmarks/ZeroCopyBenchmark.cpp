@@ -0,0 +1,156 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+// measures the latency of large push updates (full-HD RGB images) between two components
+// within the same host, transferred either as shared-memory references (zero-copy) or as
+// serialized copies, from calling put() on the server until getUpdateWait() returns at the client
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+
+#include "CommImageDDS.h"
+
+// the same image, but transferred as serialized copy
+namespace BenchmarkObjects {
+struct CopiedImage : public CommExampleObjects::CommImage { };
+}
+
+namespace SmartDDS {
+template<> struct DDSIdlType<BenchmarkObjects::CopiedImage> {
+	using type = CommExampleObjectsIdl::CommImageCopy;
+};
+}
+
+#include "RTI-DDS-SmartSoft/Component.h"
+#include "RTI-DDS-SmartSoft/LocalServiceRegistry.h"
+#include "RTI-DDS-SmartSoft/PushClientPattern.h"
+#include "RTI-DDS-SmartSoft/PushServerPattern.h"
+
+// returns the sorted latencies (in milliseconds) of the given number of updates (or nothing if the updates failed)
+template <class ImageType>
+static std::vector<double> run(const std::string &service_name, const size_t &updates)
+{
+	// each component has its own participant, so the updates are transferred through the shared-memory transport
+	SmartDDS::Component server_component("ZeroCopyBenchmarkServer", 0, SmartDDS::DDSTransport::SharedMemory);
+	SmartDDS::Component client_component("ZeroCopyBenchmarkClient", 0, SmartDDS::DDSTransport::SharedMemory);
+	SmartDDS::PushServerPattern<ImageType> server(&server_component, service_name);
+	SmartDDS::PushClientPattern<ImageType> client(&client_component);
+	if(client.connect("ZeroCopyBenchmarkServer", service_name) != Smart::StatusCode::SMART_OK
+			|| client.subscribe() != Smart::StatusCode::SMART_OK) {
+		std::cerr << "could not subscribe to " << service_name << std::endl;
+		return std::vector<double>();
+	}
+
+	ImageType image;
+	image.width = 1920;
+	image.height = 1080;
+	image.data.assign(image.width * image.height * 3, 0x7f);
+
+	// the first updates can get lost until the reader is matched with the writer (and warm up the caches)
+	ImageType received_image;
+	image.sequence_number = 0;
+	size_t received_warm_up_updates = 0;
+	for(int retry=0; retry<100 && received_warm_up_updates < 10; ++retry) {
+		server.put(image);
+		if(client.getUpdateWait(received_image, std::chrono::milliseconds(100)) == Smart::StatusCode::SMART_OK) {
+			received_warm_up_updates++;
+		}
+	}
+
+	std::vector<double> latencies;
+	for(size_t update=1; update<=updates; ++update) {
+		image.sequence_number = update;
+		auto start = std::chrono::steady_clock::now();
+		if(server.put(image) != Smart::StatusCode::SMART_OK) {
+			break;
+		}
+		// skips older (late) updates
+		auto status = Smart::StatusCode::SMART_OK;
+		do {
+			status = client.getUpdateWait(received_image, std::chrono::seconds(1));
+		} while(status == Smart::StatusCode::SMART_OK && received_image.sequence_number < update);
+		if(status != Smart::StatusCode::SMART_OK) {
+			break;
+		}
+		std::chrono::duration<double, std::milli> latency = std::chrono::steady_clock::now() - start;
+		latencies.push_back(latency.count());
+	}
+	client.disconnect();
+	if(latencies.size() != updates) {
+		std::cerr << "only " << latencies.size() << " of " << updates << " updates were received" << std::endl;
+		return std::vector<double>();
+	}
+	std::sort(latencies.begin(), latencies.end());
+	return latencies;
+}
+
+static void print(const std::string &name, const std::vector<double> &latencies)
+{
+	std::cout << std::setw(14) << name;
+	if(latencies.empty()) {
+		std::cout << std::setw(12) << "failed" << std::endl;
+		return;
+	}
+	std::cout << std::setw(12) << std::fixed << std::setprecision(2) << latencies[latencies.size()/2]
+			<< std::setw(12) << latencies[latencies.size()*99/100]
+			<< std::setw(12) << latencies.back() << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t updates = 200;
+	if(argc > 1) {
+		updates = std::stoul(argv[1]);
+	}
+	// the updates are transferred through DDS (and not through the in-process short-cut)
+	SmartDDS::LocalServiceRegistry::instance().setEnabled(false);
+
+	std::cout << "ms from put() until getUpdateWait() returns for 1920x1080x3 byte images, " << updates << " updates" << std::endl;
+	std::cout << std::setw(14) << "transfer" << std::setw(12) << "median" << std::setw(12) << "99%" << std::setw(12) << "max" << std::endl;
+	print("copy", run<BenchmarkObjects::CopiedImage>("CopiedImageService", updates));
+	print("zero-copy", run<CommExampleObjects::CommImage>("ZeroCopyImageService", updates));
+	return 0;
+}
@@ -0,0 +1,45 @@
+#!/bin/bash
+#
+# Measures the throughput of the example QueryServer with 1 up to N worker threads
+# (the default of N is the number of cores), e.g.:
+#
+#   ./run_query_server_scaling.sh <build-directory> [N]
+#
+# For each number of workers, the example QueryServer is started with a WorkStealingQueryHandler
+# and the QueryServerScalingBenchmark sends 2000 pipelined queries to it.
+
+BUILD_DIR=${1:-.}
+MAX_WORKERS=${2:-$(nproc)}
+
+SERVER=$(find "$BUILD_DIR" -type f -name QueryServer -perm -u+x | head -1)
+CLIENT=$(find "$BUILD_DIR" -type f -name QueryServerScalingBenchmark -perm -u+x | head -1)
+if [ -z "$SERVER" ] || [ -z "$CLIENT" ]; then
+	echo "QueryServer or QueryServerScalingBenchmark not found in $BUILD_DIR"
+	exit 1
+fi
+
+WORKER_COUNTS=""
+for (( WORKERS=1; WORKERS<MAX_WORKERS; WORKERS*=2 )); do
+	WORKER_COUNTS="$WORKER_COUNTS $WORKERS"
+done
+WORKER_COUNTS="$WORKER_COUNTS $MAX_WORKERS"
+
+printf "%8s %14s %9s\n" "workers" "queries/s" "speedup"
+SINGLE_WORKER_RATE=""
+for WORKERS in $WORKER_COUNTS; do
+	# each run uses an own server name, so the client does not connect to a previous server
+	SERVER_NAME="QueryServerScaling$WORKERS"
+	"$SERVER" "$SERVER_NAME" "$WORKERS" > /dev/null &
+	SERVER_PID=$!
+	RATE=$("$CLIENT" "$SERVER_NAME")
+	kill -INT $SERVER_PID
+	wait $SERVER_PID 2> /dev/null
+	if [ -z "$RATE" ]; then
+		printf "%8s %14s\n" "$WORKERS" "failed"
+		continue
+	fi
+	if [ -z "$SINGLE_WORKER_RATE" ]; then
+		SINGLE_WORKER_RATE=$RATE
+	fi
+	printf "%8s %14s %8.2fx\n" "$WORKERS" "$RATE" "$(awk "BEGIN { print $RATE / $SINGLE_WORKER_RATE }")"
+done
@@ -0,0 +1,87 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+#include <algorithm>
+
+#include "CommImageDDS.h"
+
+// both IDL types have the same members
+template <class SampleType>
+static void serialize_image(const CommExampleObjects::CommImage &object, SampleType &sample)
+{
+	sample.sequence_number(object.sequence_number);
+	sample.width(object.width);
+	sample.height(object.height);
+	// larger images are truncated to the maximal size of the IDL type
+	auto data_size = std::min<size_t>(object.data.size(), sample.data().size());
+	std::copy_n(object.data.begin(), data_size, sample.data().begin());
+	sample.data_size(static_cast<uint32_t>(data_size));
+}
+
+template <class SampleType>
+static void convert_image(const SampleType &sample, CommExampleObjects::CommImage &object)
+{
+	object.sequence_number = sample.sequence_number();
+	object.width = sample.width();
+	object.height = sample.height();
+	auto data_size = std::min<size_t>(sample.data_size(), sample.data().size());
+	object.data.assign(sample.data().begin(), sample.data().begin() + data_size);
+}
+
+void serialize(const CommExampleObjects::CommImage &object, CommExampleObjectsIdl::CommImage &sample)
+{
+	serialize_image(object, sample);
+}
+
+void convert(const CommExampleObjectsIdl::CommImage &sample, CommExampleObjects::CommImage &object)
+{
+	convert_image(sample, object);
+}
+
+void serialize(const CommExampleObjects::CommImage &object, CommExampleObjectsIdl::CommImageCopy &sample)
+{
+	serialize_image(object, sample);
+}
+
+void convert(const CommExampleObjectsIdl::CommImageCopy &sample, CommExampleObjects::CommImage &object)
+{
+	convert_image(sample, object);
+}
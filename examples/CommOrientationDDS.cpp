@@ -56,13 +56,16 @@ StructType dds_type<CommExampleObjects::CommOrientation>()
 
 DynamicData serialize(const CommExampleObjects::CommOrientation &object)
 {
-	DynamicData data(dds_type<CommExampleObjects::CommOrientation>());
+	DynamicData data(SmartDDS::DDSTypeRegistry::get<CommExampleObjects::CommOrientation>());
+	serialize_into(data, object);
+	return data;
+}
 
+void serialize_into(DynamicData &data, const CommExampleObjects::CommOrientation &object)
+{
 	data.value<double>("pitch", object.pitch);
 	data.value<double>("yaw", object.yaw);
 	data.value<double>("roll", object.roll);
-
-	return data;
 }
 
 void convert(const DynamicData &data, CommExampleObjects::CommOrientation &object)
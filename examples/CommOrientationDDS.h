@@ -43,6 +43,8 @@
 #define EXAMPLES_COMMORIENTATIONDDS_H_
 
 #include <dds/dds.hpp>
+
+#include "RTI-DDS-SmartSoft/DDSTypeRegistry.h"
 #include "CommOrientation.h"
 
 // forward declaration
@@ -55,6 +57,14 @@ dds::core::xtypes::StructType dds_type<CommExampleObjects::CommOrientation>();
 
 dds::core::xtypes::DynamicData serialize(const CommExampleObjects::CommOrientation &object);
 
+// fills a pre-built sample (allows reusing samples without allocations, see SmartDDS::DDSSamplePool)
+void serialize_into(dds::core::xtypes::DynamicData &data, const CommExampleObjects::CommOrientation &object);
+
+namespace SmartDDS {
+template<> struct DDSSerializeInto<CommExampleObjects::CommOrientation>
+:	DDSSerializeIntoFunction<CommExampleObjects::CommOrientation, &::serialize_into> {};
+}
+
 void convert(const dds::core::xtypes::DynamicData &data, CommExampleObjects::CommOrientation &object);
 
 #endif /* EXAMPLES_COMMORIENTATIONDDS_H_ */
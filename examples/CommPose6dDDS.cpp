@@ -47,24 +47,51 @@ template<>
 StructType dds_type<CommExampleObjects::CommPose6d>()
 {
 	StructType dynamic_dds_type("CommExampleObjects::CommPose6d");
-	dynamic_dds_type.add_member(Member("position", dds_type<CommExampleObjects::CommPosition>()));
-	dynamic_dds_type.add_member(Member("orientation", dds_type<CommExampleObjects::CommOrientation>()));
+	dynamic_dds_type.add_member(Member("position", SmartDDS::DDSTypeRegistry::get<CommExampleObjects::CommPosition>()));
+	dynamic_dds_type.add_member(Member("orientation", SmartDDS::DDSTypeRegistry::get<CommExampleObjects::CommOrientation>()));
 
     return dynamic_dds_type;
 }
 
 DynamicData serialize(const CommExampleObjects::CommPose6d &object)
 {
-	DynamicData data(dds_type<CommExampleObjects::CommPose6d>());
-
-	data.value("position", serialize(object.position));
-	data.value("orientation", serialize(object.orientation));
-
+	DynamicData data(SmartDDS::DDSTypeRegistry::get<CommExampleObjects::CommPose6d>());
+	serialize_into(data, object);
 	return data;
 }
 
+void serialize_into(DynamicData &data, const CommExampleObjects::CommPose6d &object)
+{
+	auto position = data.loan_value("position");
+	serialize_into(position.get(), object.position);
+	position.return_loan();
+	auto orientation = data.loan_value("orientation");
+	serialize_into(orientation.get(), object.orientation);
+	orientation.return_loan();
+}
+
 void convert(const DynamicData &data, CommExampleObjects::CommPose6d &object)
 {
 	convert(data.value<DynamicData>("position"), object.position);
 	convert(data.value<DynamicData>("orientation"), object.orientation);
 }
+
+void serialize(const CommExampleObjects::CommPose6d &object, CommExampleObjectsIdl::CommPose6d &sample)
+{
+	sample.position().x(object.position.x);
+	sample.position().y(object.position.y);
+	sample.position().z(object.position.z);
+	sample.orientation().pitch(object.orientation.pitch);
+	sample.orientation().yaw(object.orientation.yaw);
+	sample.orientation().roll(object.orientation.roll);
+}
+
+void convert(const CommExampleObjectsIdl::CommPose6d &sample, CommExampleObjects::CommPose6d &object)
+{
+	object.position.x = sample.position().x();
+	object.position.y = sample.position().y();
+	object.position.z = sample.position().z();
+	object.orientation.pitch = sample.orientation().pitch();
+	object.orientation.yaw = sample.orientation().yaw();
+	object.orientation.roll = sample.orientation().roll();
+}
@@ -44,7 +44,10 @@
 
 #include <dds/dds.hpp>
 
+#include "RTI-DDS-SmartSoft/DDSTypeRegistry.h"
+
 #include "CommPose6d.h"
+#include "CommPose6d.hpp" // generated by rtiddsgen from CommPose6d.idl
 
 #include "CommPositionDDS.h"
 #include "CommOrientationDDS.h"
@@ -59,6 +62,25 @@ dds::core::xtypes::StructType dds_type<CommExampleObjects::CommPose6d>();
 
 dds::core::xtypes::DynamicData serialize(const CommExampleObjects::CommPose6d &object);
 
+// fills a pre-built sample (allows reusing samples without allocations, see SmartDDS::DDSSamplePool)
+void serialize_into(dds::core::xtypes::DynamicData &data, const CommExampleObjects::CommPose6d &object);
+
+namespace SmartDDS {
+template<> struct DDSSerializeInto<CommExampleObjects::CommPose6d>
+:	DDSSerializeIntoFunction<CommExampleObjects::CommPose6d, &::serialize_into> {};
+}
+
 void convert(const dds::core::xtypes::DynamicData &data, CommExampleObjects::CommPose6d &object);
 
+// the pose is transmitted using its IDL-generated type (the DynamicData functions above remain available, e.g. for benchmarks)
+namespace SmartDDS {
+template<> struct DDSIdlType<CommExampleObjects::CommPose6d> {
+	using type = CommExampleObjectsIdl::CommPose6d;
+};
+}
+
+void serialize(const CommExampleObjects::CommPose6d &object, CommExampleObjectsIdl::CommPose6d &sample);
+
+void convert(const CommExampleObjectsIdl::CommPose6d &sample, CommExampleObjects::CommPose6d &object);
+
 #endif /* EXAMPLES_COMMPOSE6DDDS_H_ */
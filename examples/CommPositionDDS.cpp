@@ -56,13 +56,16 @@ StructType dds_type<CommExampleObjects::CommPosition>()
 
 DynamicData serialize(const CommExampleObjects::CommPosition &object)
 {
-	DynamicData data(dds_type<CommExampleObjects::CommPosition>());
+	DynamicData data(SmartDDS::DDSTypeRegistry::get<CommExampleObjects::CommPosition>());
+	serialize_into(data, object);
+	return data;
+}
 
+void serialize_into(DynamicData &data, const CommExampleObjects::CommPosition &object)
+{
 	data.value<double>("x", object.x);
 	data.value<double>("y", object.y);
 	data.value<double>("z", object.z);
-
-	return data;
 }
 
 void convert(const DynamicData &data, CommExampleObjects::CommPosition &object)
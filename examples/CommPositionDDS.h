@@ -43,6 +43,8 @@
 #define EXAMPLES_COMMPOSITIONDDS_H_
 
 #include <dds/dds.hpp>
+
+#include "RTI-DDS-SmartSoft/DDSTypeRegistry.h"
 #include "CommPosition.h"
 
 // forward declaration
@@ -55,6 +57,14 @@ dds::core::xtypes::StructType dds_type<CommExampleObjects::CommPosition>();
 
 dds::core::xtypes::DynamicData serialize(const CommExampleObjects::CommPosition &object);
 
+// fills a pre-built sample (allows reusing samples without allocations, see SmartDDS::DDSSamplePool)
+void serialize_into(dds::core::xtypes::DynamicData &data, const CommExampleObjects::CommPosition &object);
+
+namespace SmartDDS {
+template<> struct DDSSerializeInto<CommExampleObjects::CommPosition>
+:	DDSSerializeIntoFunction<CommExampleObjects::CommPosition, &::serialize_into> {};
+}
+
 void convert(const dds::core::xtypes::DynamicData &data, CommExampleObjects::CommPosition &object);
 
 #endif /* EXAMPLES_COMMPOSITIONDDS_H_ */
@@ -53,11 +53,14 @@ StructType dds_type<CommExampleObjects::CommText>()
 
 DynamicData serialize(const CommExampleObjects::CommText &object)
 {
-	DynamicData data(dds_type<CommExampleObjects::CommText>());
+	DynamicData data(SmartDDS::DDSTypeRegistry::get<CommExampleObjects::CommText>());
+	serialize_into(data, object);
+	return data;
+}
 
+void serialize_into(DynamicData &data, const CommExampleObjects::CommText &object)
+{
 	data.value<std::string>("text", object.text);
-
-	return data;
 }
 
 void convert(const DynamicData &data, CommExampleObjects::CommText &object)
@@ -43,6 +43,8 @@
 #define EXAMPLES_COMMTEXTDDS_H_
 
 #include <dds/dds.hpp>
+
+#include "RTI-DDS-SmartSoft/DDSTypeRegistry.h"
 #include "CommText.h"
 
 // forward declaration
@@ -55,6 +57,14 @@ dds::core::xtypes::StructType dds_type<CommExampleObjects::CommText>();
 
 dds::core::xtypes::DynamicData serialize(const CommExampleObjects::CommText &object);
 
+// fills a pre-built sample (allows reusing samples without allocations, see SmartDDS::DDSSamplePool)
+void serialize_into(dds::core::xtypes::DynamicData &data, const CommExampleObjects::CommText &object);
+
+namespace SmartDDS {
+template<> struct DDSSerializeInto<CommExampleObjects::CommText>
+:	DDSSerializeIntoFunction<CommExampleObjects::CommText, &::serialize_into> {};
+}
+
 void convert(const dds::core::xtypes::DynamicData &data, CommExampleObjects::CommText &object);
 
 #endif /* EXAMPLES_COMMTEXTDDS_H_ */
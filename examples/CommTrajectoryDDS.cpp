@@ -0,0 +1,100 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+#include "CommTrajectoryDDS.h"
+
+using namespace dds::core::xtypes;
+
+template<>
+StructType dds_type<CommExampleObjects::CommTrajectory>()
+{
+	StructType dynamic_dds_type("CommExampleObjects::CommTrajectory");
+	dynamic_dds_type.add_member(Member("description", StringType(512)));
+	dynamic_dds_type.add_member(Member("poses", SequenceType(SmartDDS::DDSTypeRegistry::get<CommExampleObjects::CommPose6d>(), CommExampleObjectsIdl::MAX_TRAJECTORY_POSES)));
+
+    return dynamic_dds_type;
+}
+
+DynamicData serialize(const CommExampleObjects::CommTrajectory &object)
+{
+	DynamicData data(SmartDDS::DDSTypeRegistry::get<CommExampleObjects::CommTrajectory>());
+	data.value<std::string>("description", object.description);
+
+	size_t pose_member_count = 1; // index starts from 1 (not 0)
+	auto poses_sequence_member = data.value<DynamicData>("poses");
+	for(const auto &pose: object.poses) {
+		poses_sequence_member.value(pose_member_count++, serialize(pose));
+	}
+	data.value("poses", poses_sequence_member);
+
+	return data;
+}
+
+void convert(const DynamicData &data, CommExampleObjects::CommTrajectory &object)
+{
+	object.description = data.value<std::string>("description");
+
+	object.poses.clear();
+	auto poses_sequence_member = data.value<DynamicData>("poses");
+	for(uint32_t i = 1; i <= poses_sequence_member.info().member_count(); ++i) {
+		CommExampleObjects::CommPose6d pose;
+		convert(poses_sequence_member.value<DynamicData>(i), pose);
+		object.poses.push_back(pose);
+	}
+}
+
+void serialize(const CommExampleObjects::CommTrajectory &object, CommExampleObjectsIdl::CommTrajectory &sample)
+{
+	sample.description(object.description);
+	sample.poses().resize(object.poses.size());
+	for(size_t i=0; i<object.poses.size(); ++i) {
+		serialize(object.poses[i], sample.poses()[i]);
+	}
+}
+
+void convert(const CommExampleObjectsIdl::CommTrajectory &sample, CommExampleObjects::CommTrajectory &object)
+{
+	object.description = sample.description();
+	object.poses.resize(sample.poses().size());
+	for(size_t i=0; i<sample.poses().size(); ++i) {
+		convert(sample.poses()[i], object.poses[i]);
+	}
+}
@@ -45,6 +45,7 @@
 #include "RTI-DDS-SmartSoft/QueryServerPattern.h"
 #include "RTI-DDS-SmartSoft/ProcessingPatterns.h"
 
+#include <cmath>
 #include <iostream>
 
 class MyStringHandler
@@ -80,21 +81,53 @@ public:
 	virtual ~MyStringHandler() = default;
 };
 
+// simulates a CPU-heavy handler (e.g. an IK solver) by a fixed amount of computation per query
+class MyComputationHandler
+:	public SmartDDS::QueryServerHandler<CommExampleObjects::CommPosition,CommExampleObjects::CommPose6d>
+{
+private:
+	virtual void handleQuery(IQueryServer &server, const Smart::QueryIdPtr &id, const CommExampleObjects::CommPosition& request) override
+	{
+		CommExampleObjects::CommPose6d response;
+		response.position = request;
+		double value = request.x;
+		for(int i=0; i<100000; ++i) {
+			value = std::sin(value) + request.y;
+		}
+		response.orientation.yaw = value;
+		server.answer(id, response);
+	}
+public:
+	virtual ~MyComputationHandler() = default;
+};
+
 using ActiveStringHandler = SmartDDS::ThreadQueueQueryHandler<CommExampleObjects::CommPosition,CommExampleObjects::CommPose6d>;
+using PoolHandler = SmartDDS::WorkStealingQueryHandler<CommExampleObjects::CommPosition,CommExampleObjects::CommPose6d>;
 
 class ServerApplication {
 private:
 	SmartDDS::Component component;
 	std::shared_ptr<MyStringHandler> handler;
 	std::shared_ptr<ActiveStringHandler> active_handler;
+	std::shared_ptr<PoolHandler> pool_handler;
 	SmartDDS::QueryServerPattern<CommExampleObjects::CommPosition,CommExampleObjects::CommPose6d> queryServer;
 
+	// with a number of workers, the queries are computed in parallel by a pool of threads (see benchmarks/run_query_server_scaling.sh)
+	std::shared_ptr<Smart::IQueryServerHandler<CommExampleObjects::CommPosition,CommExampleObjects::CommPose6d>>
+	createHandler(const unsigned int &workers) {
+		if(workers == 0) {
+			return handler;
+		}
+		pool_handler = std::make_shared<PoolHandler>(&component, std::make_shared<MyComputationHandler>(), workers);
+		return pool_handler;
+	}
+
 public:
-	ServerApplication(const std::string &componentName, const std::string &serviceName)
+	ServerApplication(const std::string &componentName, const std::string &serviceName, const unsigned int &workers = 0)
 	:	component(componentName)
 	,	handler(std::make_shared<MyStringHandler>())
 	,	active_handler(std::make_shared<ActiveStringHandler>(&component, handler))
-	,	queryServer(&component, serviceName, handler)
+	,	queryServer(&component, serviceName, createHandler(workers))
 	{  }
 
 	void run() {
@@ -108,9 +141,13 @@ int main(int argc, char* argv[]) {
 	if(argc > 1) {
 		componentName = argv[1];
 	}
+	unsigned int workers = 0;
+	if(argc > 2) {
+		workers = std::stoul(argv[2]);
+	}
 	std::string serviceName = "TextService";
 
-	ServerApplication application(componentName, serviceName);
+	ServerApplication application(componentName, serviceName, workers);
 	application.run();
 	return 0;
 }
@@ -58,7 +58,7 @@ StructType dds_type<CommTestObjects::Comm3dPose>()
 
 DynamicData serialize(const CommTestObjects::Comm3dPose &object)
 {
-	DynamicData data(dds_type<CommTestObjects::Comm3dPose>());
+	DynamicData data(SmartDDS::DDSTypeRegistry::get<CommTestObjects::Comm3dPose>());
 
 	data.value<int32_t>("x", object.x);
 	data.value<int32_t>("y", object.y);
@@ -45,6 +45,8 @@
 
 #include <dds/dds.hpp>
 
+#include "RTI-DDS-SmartSoft/DDSTypeRegistry.h"
+
 #include <SmartSoftTests/CommTestObjects/Comm3dPose.h>
 
 // forward declaration
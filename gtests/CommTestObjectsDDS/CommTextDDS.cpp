@@ -56,7 +56,7 @@ StructType dds_type<CommTestObjects::CommText>()
 
 DynamicData serialize(const CommTestObjects::CommText &object)
 {
-	DynamicData data(dds_type<CommTestObjects::CommText>());
+	DynamicData data(SmartDDS::DDSTypeRegistry::get<CommTestObjects::CommText>());
 
 	data.value<std::string>("text", object.text);
 
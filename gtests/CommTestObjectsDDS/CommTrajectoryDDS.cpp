@@ -49,15 +49,15 @@ StructType dds_type<CommTestObjects::CommTrajectory>()
 {
 	StructType dynamic_dds_type(CommTestObjects::CommTrajectory::identifier());
 
-	dynamic_dds_type.add_member(Member("description", dds_type<CommTestObjects::CommText>()));
-	dynamic_dds_type.add_member(Member("trajectory", SequenceType(dds_type<CommTestObjects::Comm3dPose>())));
+	dynamic_dds_type.add_member(Member("description", SmartDDS::DDSTypeRegistry::get<CommTestObjects::CommText>()));
+	dynamic_dds_type.add_member(Member("trajectory", SequenceType(SmartDDS::DDSTypeRegistry::get<CommTestObjects::Comm3dPose>())));
 
     return dynamic_dds_type;
 }
 
 DynamicData serialize(const CommTestObjects::CommTrajectory &object)
 {
-	DynamicData data(dds_type<CommTestObjects::CommTrajectory>());
+	DynamicData data(SmartDDS::DDSTypeRegistry::get<CommTestObjects::CommTrajectory>());
 
 	data.value("description", serialize(object.description));
 
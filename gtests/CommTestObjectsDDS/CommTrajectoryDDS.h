@@ -45,6 +45,8 @@
 
 #include <dds/dds.hpp>
 
+#include "RTI-DDS-SmartSoft/DDSTypeRegistry.h"
+
 #include "CommTextDDS.h"
 #include "Comm3dPoseDDS.h"
 
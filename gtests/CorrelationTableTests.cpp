@@ -0,0 +1,113 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "RTI-DDS-SmartSoft/CorrelationTable.h"
+
+static SmartDDS::CorrelationKey createKey(const uint8_t &writer, const int64_t &sequence_number)
+{
+	rti::core::Guid guid;
+	guid[0] = writer;
+	guid[15] = writer;
+	return SmartDDS::CorrelationKey(rti::core::SampleIdentity(guid, rti::core::SequenceNumber(sequence_number)));
+}
+
+TEST(CorrelationTableTest, InsertFindAndErase)
+{
+	SmartDDS::CorrelationTable<int> table;
+	for(int i=0; i<1000; ++i) {
+		table.insert(createKey(1, i), i);
+		table.insert(createKey(2, i), -i);
+	}
+	EXPECT_EQ(table.size(), 2000u);
+
+	int value = 0;
+	EXPECT_TRUE(table.find(createKey(1, 42), value));
+	EXPECT_EQ(value, 42);
+	EXPECT_TRUE(table.find(createKey(2, 42), value));
+	EXPECT_EQ(value, -42);
+	EXPECT_FALSE(table.find(createKey(3, 42), value));
+
+	// erasing every other entry must keep the remaining entries reachable (backward-shift deletion)
+	for(int i=0; i<1000; i+=2) {
+		EXPECT_TRUE(table.erase(createKey(1, i)));
+	}
+	EXPECT_FALSE(table.erase(createKey(1, 0)));
+	for(int i=1; i<1000; i+=2) {
+		EXPECT_TRUE(table.find(createKey(1, i), value));
+		EXPECT_EQ(value, i);
+	}
+
+	EXPECT_TRUE(table.take(createKey(2, 7), value));
+	EXPECT_EQ(value, -7);
+	EXPECT_EQ(table.size(), 1499u);
+
+	EXPECT_EQ(table.takeAll().size(), 1499u);
+	EXPECT_EQ(table.size(), 0u);
+	EXPECT_FALSE(table.find(createKey(1, 1), value));
+}
+
+TEST(CorrelationTableTest, ConcurrentWriters)
+{
+	SmartDDS::CorrelationTable<int> table;
+	std::vector<std::thread> threads;
+	for(uint8_t writer=0; writer<4; ++writer) {
+		threads.emplace_back([&table, writer]() {
+			for(int i=0; i<10000; ++i) {
+				table.insert(createKey(writer, i), i);
+				int value = -1;
+				EXPECT_TRUE(table.find(createKey(writer, i), value));
+				if(i % 2 == 0) {
+					EXPECT_TRUE(table.erase(createKey(writer, i)));
+				}
+			}
+		});
+	}
+	for(auto &thread: threads) {
+		thread.join();
+	}
+	EXPECT_EQ(table.size(), 4*5000u);
+}
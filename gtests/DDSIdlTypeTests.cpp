@@ -0,0 +1,198 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+// This test uses the IDL-generated example communication objects, so it is built as its own executable (see CMakeLists.txt).
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "CommPose6dDDS.h"
+#include "CommTrajectoryDDS.h"
+#include "CommImageDDS.h"
+
+#include "RTI-DDS-SmartSoft/Component.h"
+#include "RTI-DDS-SmartSoft/LocalServiceRegistry.h"
+#include "RTI-DDS-SmartSoft/PushClientPattern.h"
+#include "RTI-DDS-SmartSoft/PushServerPattern.h"
+
+using CommExampleObjects::CommPose6d;
+using CommExampleObjects::CommTrajectory;
+using CommExampleObjects::CommImage;
+
+static CommPose6d createPose(const double &value)
+{
+	CommPose6d pose;
+	pose.position.x = value;
+	pose.position.y = value + 1.0;
+	pose.position.z = value + 2.0;
+	pose.orientation.pitch = value + 3.0;
+	pose.orientation.yaw = value + 4.0;
+	pose.orientation.roll = value + 5.0;
+	return pose;
+}
+
+static CommTrajectory createTrajectory(const size_t &size)
+{
+	CommTrajectory trajectory;
+	trajectory.description = "trajectory with " + std::to_string(size) + " poses";
+	for(size_t i=0; i<size; ++i) {
+		trajectory.poses.push_back(createPose(i));
+	}
+	return trajectory;
+}
+
+static void expectEqual(const CommPose6d &expected, const CommPose6d &actual)
+{
+	EXPECT_EQ(expected.position.x, actual.position.x);
+	EXPECT_EQ(expected.position.y, actual.position.y);
+	EXPECT_EQ(expected.position.z, actual.position.z);
+	EXPECT_EQ(expected.orientation.pitch, actual.orientation.pitch);
+	EXPECT_EQ(expected.orientation.yaw, actual.orientation.yaw);
+	EXPECT_EQ(expected.orientation.roll, actual.orientation.roll);
+}
+
+static void expectEqual(const CommTrajectory &expected, const CommTrajectory &actual)
+{
+	EXPECT_EQ(expected.description, actual.description);
+	ASSERT_EQ(expected.poses.size(), actual.poses.size());
+	for(size_t i=0; i<expected.poses.size(); ++i) {
+		expectEqual(expected.poses[i], actual.poses[i]);
+	}
+}
+
+static void expectEqual(const CommImage &expected, const CommImage &actual)
+{
+	EXPECT_EQ(expected.sequence_number, actual.sequence_number);
+	EXPECT_EQ(expected.width, actual.width);
+	EXPECT_EQ(expected.height, actual.height);
+	EXPECT_EQ(expected.data, actual.data);
+}
+
+TEST(DDSIdlTypeTest, SelectsTheTypedPath)
+{
+	EXPECT_FALSE(SmartDDS::DDSTypeTraits<CommPose6d>::is_dynamic);
+	EXPECT_FALSE(SmartDDS::DDSTypeTraits<CommTrajectory>::is_dynamic);
+	EXPECT_FALSE(SmartDDS::DDSTypeTraits<CommTrajectory>::zero_copy);
+	EXPECT_TRUE(SmartDDS::DDSTypeTraits<CommImage>::zero_copy);
+	// the nested communication objects keep using DynamicData
+	EXPECT_TRUE(SmartDDS::DDSTypeTraits<CommExampleObjects::CommPosition>::is_dynamic);
+}
+
+// serializes the typed sample into its CDR representation and back (as done by the middleware)
+template <class DataType>
+static void testCdrRoundTrip(const DataType &object)
+{
+	using Traits = SmartDDS::DDSTypeTraits<DataType>;
+	using SampleType = typename Traits::SampleType;
+
+	auto sample = Traits::toSample(object);
+	std::vector<char> buffer;
+	dds::topic::topic_type_support<SampleType>::to_cdr_buffer(buffer, sample);
+
+	SampleType received_sample;
+	dds::topic::topic_type_support<SampleType>::from_cdr_buffer(received_sample, buffer);
+	DataType received_object;
+	Traits::fromSample(received_sample, received_object);
+	expectEqual(object, received_object);
+}
+
+TEST(DDSIdlTypeTest, CdrRoundTripOfPose)
+{
+	testCdrRoundTrip(createPose(42.0));
+}
+
+TEST(DDSIdlTypeTest, CdrRoundTripOfTrajectory)
+{
+	testCdrRoundTrip(createTrajectory(0));
+	testCdrRoundTrip(createTrajectory(1000));
+}
+
+// transmits the object from a PushServerPattern to a PushClientPattern through DDS
+template <class DataType>
+static void testPushRoundTrip(const std::string &service_name, const DataType &object)
+{
+	// the local short-circuit would bypass the DDS types
+	SmartDDS::LocalServiceRegistry::instance().setEnabled(false);
+
+	SmartDDS::Component component("DDSIdlTypeTestComponent");
+	SmartDDS::PushServerPattern<DataType> server(&component, service_name);
+	SmartDDS::PushClientPattern<DataType> client(&component);
+	ASSERT_EQ(client.connect("DDSIdlTypeTestComponent", service_name), Smart::StatusCode::SMART_OK);
+	ASSERT_EQ(client.subscribe(), Smart::StatusCode::SMART_OK);
+
+	// the first updates can get lost until the reader is matched with the writer
+	DataType received_object;
+	auto status = Smart::StatusCode::SMART_TIMEOUT;
+	for(int retry=0; retry<50 && status == Smart::StatusCode::SMART_TIMEOUT; ++retry) {
+		ASSERT_EQ(server.put(object), Smart::StatusCode::SMART_OK);
+		status = client.getUpdateWait(received_object, std::chrono::milliseconds(100));
+	}
+	ASSERT_EQ(status, Smart::StatusCode::SMART_OK);
+	expectEqual(object, received_object);
+
+	EXPECT_EQ(client.disconnect(), Smart::StatusCode::SMART_OK);
+	SmartDDS::LocalServiceRegistry::instance().setEnabled(true);
+}
+
+TEST(DDSIdlTypeTest, PushRoundTripOfPose)
+{
+	testPushRoundTrip("IdlPoseService", createPose(42.0));
+}
+
+TEST(DDSIdlTypeTest, PushRoundTripOfTrajectory)
+{
+	testPushRoundTrip("IdlTrajectoryService", createTrajectory(1000));
+}
+
+TEST(DDSIdlTypeTest, PushRoundTripOfZeroCopyImage)
+{
+	CommImage image;
+	image.sequence_number = 42;
+	image.width = 640;
+	image.height = 480;
+	for(size_t i=0; i<image.width*image.height*3; ++i) {
+		image.data.push_back(static_cast<uint8_t>(i));
+	}
+	testPushRoundTrip("ZeroCopyImageService", image);
+}
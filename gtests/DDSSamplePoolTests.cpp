@@ -0,0 +1,218 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+// This test replaces the global allocation functions, so it is built as its own executable (see CMakeLists.txt).
+
+#include <atomic>
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+
+#include "RTI-DDS-SmartSoft/DDSTypeRegistry.h"
+
+// counts the heap allocations of the test thread while counting is enabled (allocations of the
+// DDS-internal threads are not related to the write call and would make the test flaky)
+static thread_local bool count_allocations = false;
+static std::atomic<size_t> allocation_counter(0);
+
+#ifdef __GLIBC__
+// glibc allows interposing malloc() and friends, which also covers the allocations of the
+// RTI C core and of the default operator new. Aligned allocations (memalign() and posix_memalign())
+// are not counted.
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void *ptr, size_t size);
+
+void* malloc(size_t size)
+{
+	if(count_allocations) {
+		++allocation_counter;
+	}
+	return __libc_malloc(size);
+}
+void* calloc(size_t count, size_t size)
+{
+	if(count_allocations) {
+		++allocation_counter;
+	}
+	return __libc_calloc(count, size);
+}
+void* realloc(void *ptr, size_t size)
+{
+	if(count_allocations) {
+		++allocation_counter;
+	}
+	return __libc_realloc(ptr, size);
+}
+} /* extern "C" */
+#else
+// without glibc only the C++ allocations are counted (i.e. allocations of the RTI C core are missed)
+#include <new>
+
+void* operator new(std::size_t size)
+{
+	if(count_allocations) {
+		++allocation_counter;
+	}
+	if(void *ptr = std::malloc(size == 0 ? 1 : size)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept
+{
+	std::free(ptr);
+}
+void operator delete(void *ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+#endif
+
+namespace SamplePoolTestObjects {
+struct CommSamplePoolTest {
+	double x = 0.0;
+	double y = 0.0;
+	int32_t counter = 0;
+};
+} /* namespace SamplePoolTestObjects */
+
+template<>
+dds::core::xtypes::StructType dds_type<SamplePoolTestObjects::CommSamplePoolTest>()
+{
+	using namespace dds::core::xtypes;
+	StructType dynamic_dds_type("SamplePoolTestObjects::CommSamplePoolTest");
+	dynamic_dds_type.add_member(Member("x", primitive_type<double>()));
+	dynamic_dds_type.add_member(Member("y", primitive_type<double>()));
+	dynamic_dds_type.add_member(Member("counter", primitive_type<int32_t>()));
+	return dynamic_dds_type;
+}
+
+void serialize_into(dds::core::xtypes::DynamicData &data, const SamplePoolTestObjects::CommSamplePoolTest &object);
+
+namespace SmartDDS {
+template<> struct DDSSerializeInto<SamplePoolTestObjects::CommSamplePoolTest>
+:	DDSSerializeIntoFunction<SamplePoolTestObjects::CommSamplePoolTest, &::serialize_into> {};
+}
+
+void serialize_into(dds::core::xtypes::DynamicData &data, const SamplePoolTestObjects::CommSamplePoolTest &object)
+{
+	data.value<double>("x", object.x);
+	data.value<double>("y", object.y);
+	data.value<int32_t>("counter", object.counter);
+}
+
+dds::core::xtypes::DynamicData serialize(const SamplePoolTestObjects::CommSamplePoolTest &object)
+{
+	dds::core::xtypes::DynamicData data(SmartDDS::DDSTypeRegistry::get<SamplePoolTestObjects::CommSamplePoolTest>());
+	serialize_into(data, object);
+	return data;
+}
+
+void convert(const dds::core::xtypes::DynamicData &data, SamplePoolTestObjects::CommSamplePoolTest &object)
+{
+	object.x = data.value<double>("x");
+	object.y = data.value<double>("y");
+	object.counter = data.value<int32_t>("counter");
+}
+
+#include "RTI-DDS-SmartSoft/DDSSamplePool.h"
+
+using SamplePoolTestObjects::CommSamplePoolTest;
+
+TEST(DDSSamplePoolTest, UsesSerializeInto)
+{
+	EXPECT_TRUE(SmartDDS::DDSSerializeInto<CommSamplePoolTest>::value);
+}
+
+TEST(DDSSamplePoolTest, ReusesReleasedSamples)
+{
+	SmartDDS::DDSSamplePool<CommSamplePoolTest> sample_pool(2);
+	EXPECT_EQ(sample_pool.size(), 0u);
+	{
+		CommSamplePoolTest object;
+		object.counter = 42;
+		auto sample = sample_pool.acquire(object);
+		CommSamplePoolTest result;
+		convert(*sample, result);
+		EXPECT_EQ(result.counter, 42);
+	}
+	EXPECT_EQ(sample_pool.size(), 1u);
+	{
+		auto first = sample_pool.acquire(CommSamplePoolTest());
+		auto second = sample_pool.acquire(CommSamplePoolTest());
+		auto third = sample_pool.acquire(CommSamplePoolTest());
+	}
+	// the pool keeps at most the configured number of samples
+	EXPECT_EQ(sample_pool.size(), 2u);
+}
+
+TEST(DDSSamplePoolTest, NoAllocationsAfterWarmUp)
+{
+	SmartDDS::DDSSamplePool<CommSamplePoolTest> sample_pool;
+	CommSamplePoolTest object;
+
+	// a writer without matching readers (the write path up to the writer queue is measured)
+	dds::domain::DomainParticipant participant(0);
+	SmartDDS::DynamicDataTopic topic(participant, "DDSSamplePoolTest", SmartDDS::DDSTypeRegistry::get<CommSamplePoolTest>());
+	SmartDDS::DynamicDataWriter writer(dds::pub::Publisher(participant), topic);
+
+	// warm-up (creates the first pooled sample and fills the writer's pre-allocated queue)
+	for(int i=0; i<10; ++i) {
+		object.counter = i;
+		auto sample = sample_pool.acquire(object);
+		writer.write(*sample);
+	}
+
+	allocation_counter = 0;
+	count_allocations = true;
+	for(int i=0; i<1000; ++i) {
+		object.x = i * 0.5;
+		object.counter = i;
+		auto sample = sample_pool.acquire(object);
+		writer.write(*sample);
+	}
+	count_allocations = false;
+
+	EXPECT_EQ(allocation_counter.load(), 0u);
+}
@@ -0,0 +1,298 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "CommTestObjectsDDS/CommTextDDS.h"
+
+#include "RTI-DDS-SmartSoft/Component.h"
+#include "RTI-DDS-SmartSoft/PushClientPattern.h"
+#include "RTI-DDS-SmartSoft/PushServerPattern.h"
+#include "RTI-DDS-SmartSoft/QueryClientPattern.h"
+#include "RTI-DDS-SmartSoft/QueryServerPattern.h"
+
+using CommTestObjects::CommText;
+
+// unsubscribes (or disconnects) the client from within the first update notification
+class UnsubscribingObserver : public SmartDDS::PushUpdateObserver<CommText> {
+private:
+	SmartDDS::PushClientPattern<CommText> *client;
+	const bool disconnect;
+	std::atomic<int> updates;
+	std::promise<Smart::StatusCode> result;
+
+public:
+	UnsubscribingObserver(SmartDDS::PushClientPattern<CommText> *client, const bool &disconnect)
+	:	client(client)
+	,	disconnect(disconnect)
+	,	updates(0)
+	{  }
+
+	std::future<Smart::StatusCode> getResult() {
+		return result.get_future();
+	}
+	int getUpdates() const {
+		return updates;
+	}
+
+	virtual void on_push_update(const std::shared_ptr<const CommText>&, const std::chrono::system_clock::time_point&) override
+	{
+		if(updates++ == 0) {
+			result.set_value(disconnect ? client->disconnect() : client->unsubscribe());
+		}
+	}
+};
+
+// blocks the first update notification until it is released
+class BlockingObserver : public SmartDDS::PushUpdateObserver<CommText> {
+private:
+	std::atomic<int> updates;
+	std::promise<void> release_promise;
+	std::shared_future<void> released;
+
+public:
+	BlockingObserver()
+	:	updates(0)
+	,	released(release_promise.get_future())
+	{  }
+
+	void release() {
+		release_promise.set_value();
+	}
+	int getUpdates() const {
+		return updates;
+	}
+
+	virtual void on_push_update(const std::shared_ptr<const CommText>&, const std::chrono::system_clock::time_point&) override
+	{
+		if(updates++ == 0) {
+			released.wait();
+		}
+	}
+};
+
+// records the connection IDs of the received queries and answers each query right away
+class ConnectionRecordingHandler : public Smart::IQueryServerHandler<CommText, CommText> {
+private:
+	std::mutex ids_mutex;
+	std::vector<SmartDDS::ConnectionId> connection_ids;
+
+public:
+	std::vector<SmartDDS::ConnectionId> getConnectionIds() {
+		std::unique_lock<std::mutex> ids_lock(ids_mutex);
+		return connection_ids;
+	}
+
+	virtual void handleQuery(Smart::IQueryServerPattern<CommText, CommText> &server, const Smart::QueryIdPtr &id, const CommText &request) override
+	{
+		auto correlation_id = std::dynamic_pointer_cast<SmartDDS::CorrelationId>(id);
+		if(correlation_id) {
+			std::unique_lock<std::mutex> ids_lock(ids_mutex);
+			connection_ids.push_back(correlation_id->getConnectionId());
+		}
+		server.answer(id, request);
+	}
+};
+
+static void testUnsubscribeFromObserver(const std::string &service_name, const bool &disconnect)
+{
+	SmartDDS::Component component("LocalServiceTestComponent");
+	SmartDDS::PushServerPattern<CommText> server(&component, service_name);
+	SmartDDS::PushClientPattern<CommText> client(&component);
+	ASSERT_EQ(client.connect("LocalServiceTestComponent", service_name), Smart::StatusCode::SMART_OK);
+
+	UnsubscribingObserver observer(&client, disconnect);
+	client.attachUpdateObserver(&observer);
+	ASSERT_EQ(client.subscribe(), Smart::StatusCode::SMART_OK);
+
+	CommText text;
+	text.text = "first";
+	ASSERT_EQ(server.put(text), Smart::StatusCode::SMART_OK);
+
+	// this used to deadlock as the observer was called while the local service was locked
+	auto result = observer.getResult();
+	ASSERT_EQ(result.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+	EXPECT_EQ(result.get(), Smart::StatusCode::SMART_OK);
+
+	text.text = "second";
+	EXPECT_EQ(server.put(text), Smart::StatusCode::SMART_OK);
+
+	CommText update;
+	if(disconnect) {
+		EXPECT_EQ(client.getUpdate(update), Smart::StatusCode::SMART_DISCONNECTED);
+	} else {
+		EXPECT_EQ(client.getUpdate(update), Smart::StatusCode::SMART_UNSUBSCRIBED);
+	}
+	client.detachUpdateObserver(&observer);
+	EXPECT_EQ(observer.getUpdates(), 1);
+}
+
+TEST(LocalServiceTest, UnsubscribeFromUpdateObserver)
+{
+	testUnsubscribeFromObserver("LocalUnsubscribeService", false);
+}
+
+TEST(LocalServiceTest, DisconnectFromUpdateObserver)
+{
+	testUnsubscribeFromObserver("LocalDisconnectService", true);
+}
+
+TEST(LocalServiceTest, SlowObserverDoesNotBlockPut)
+{
+	SmartDDS::Component component("LocalServiceTestComponent");
+	SmartDDS::PushServerPattern<CommText> server(&component, "LocalSlowObserverService");
+	SmartDDS::PushClientPattern<CommText> client(&component);
+	ASSERT_EQ(client.connect("LocalServiceTestComponent", "LocalSlowObserverService"), Smart::StatusCode::SMART_OK);
+
+	BlockingObserver observer;
+	client.attachUpdateObserver(&observer);
+	ASSERT_EQ(client.subscribe(), Smart::StatusCode::SMART_OK);
+
+	auto puts = std::async(std::launch::async, [&server]() {
+		CommText text;
+		for(int i=0; i<10; ++i) {
+			text.text = std::to_string(i);
+			if(server.put(text) != Smart::StatusCode::SMART_OK) {
+				return false;
+			}
+		}
+		return true;
+	});
+	auto puts_status = puts.wait_for(std::chrono::seconds(5));
+	observer.release();
+	ASSERT_EQ(puts_status, std::future_status::ready);
+	EXPECT_TRUE(puts.get());
+
+	// the latest value is available right away (independent of the observers)
+	CommText update;
+	EXPECT_EQ(client.getUpdate(update), Smart::StatusCode::SMART_OK);
+	EXPECT_EQ(update.text, "9");
+
+	EXPECT_EQ(client.unsubscribe(), Smart::StatusCode::SMART_OK);
+	client.detachUpdateObserver(&observer);
+	EXPECT_GE(observer.getUpdates(), 1);
+}
+
+TEST(LocalServiceTest, LocalQueryClientsHaveDistinctConnections)
+{
+	SmartDDS::Component component("LocalServiceTestComponent");
+	auto handler = std::make_shared<ConnectionRecordingHandler>();
+	SmartDDS::QueryServerPattern<CommText, CommText> server(&component, "LocalConnectionIdService", handler);
+	SmartDDS::QueryClientPattern<CommText, CommText> first_client(&component);
+	SmartDDS::QueryClientPattern<CommText, CommText> second_client(&component);
+	ASSERT_EQ(first_client.connect("LocalServiceTestComponent", "LocalConnectionIdService"), Smart::StatusCode::SMART_OK);
+	ASSERT_EQ(second_client.connect("LocalServiceTestComponent", "LocalConnectionIdService"), Smart::StatusCode::SMART_OK);
+
+	CommText request, answer;
+	request.text = "request";
+	EXPECT_EQ(first_client.query(request, answer), Smart::StatusCode::SMART_OK);
+	EXPECT_EQ(first_client.query(request, answer), Smart::StatusCode::SMART_OK);
+	EXPECT_EQ(second_client.query(request, answer), Smart::StatusCode::SMART_OK);
+
+	// the queries of one client share its connection ID (e.g. for the per-client ordering of the WorkStealingQueryHandler)
+	auto connection_ids = handler->getConnectionIds();
+	ASSERT_EQ(connection_ids.size(), 3u);
+	EXPECT_FALSE(connection_ids[0].isUnknown());
+	EXPECT_EQ(connection_ids[0], connection_ids[1]);
+	EXPECT_NE(connection_ids[0], connection_ids[2]);
+
+	EXPECT_EQ(first_client.disconnect(), Smart::StatusCode::SMART_OK);
+	EXPECT_EQ(second_client.disconnect(), Smart::StatusCode::SMART_OK);
+}
+
+TEST(LocalServiceTest, DispatchersKeepTheirOrderOnASharedPool)
+{
+	auto pool = std::make_shared<SmartDDS::LocalDispatcherPool>();
+	std::vector<std::unique_ptr<SmartDDS::LocalDispatcher>> dispatchers;
+	std::vector<std::vector<int>> deliveries(8);
+	std::atomic<int> delivered(0);
+	for(size_t i=0; i<deliveries.size(); ++i) {
+		dispatchers.emplace_back(new SmartDDS::LocalDispatcher(pool));
+	}
+	for(int k=0; k<100; ++k) {
+		for(size_t i=0; i<dispatchers.size(); ++i) {
+			EXPECT_TRUE(dispatchers[i]->post([&deliveries, &delivered, i, k]() {
+				deliveries[i].push_back(k);
+				delivered++;
+			}));
+		}
+	}
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while(delivered < 800 && std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	ASSERT_EQ(delivered.load(), 800);
+	// the deliveries of one dispatcher never run concurrently and keep their order
+	for(const auto &dispatcher_deliveries: deliveries) {
+		ASSERT_EQ(dispatcher_deliveries.size(), 100u);
+		for(int k=0; k<100; ++k) {
+			EXPECT_EQ(dispatcher_deliveries[k], k);
+		}
+	}
+	EXPECT_LE(pool->getNumberOfThreads(), dispatchers.size());
+}
+
+TEST(LocalServiceTest, BlockingDeliveryDoesNotStallThePool)
+{
+	auto pool = std::make_shared<SmartDDS::LocalDispatcherPool>();
+	SmartDDS::LocalDispatcher outer(pool), inner(pool);
+	std::promise<void> inner_done;
+	auto inner_future = inner_done.get_future();
+	std::promise<bool> outer_done;
+	auto outer_future = outer_done.get_future();
+
+	// like a handler that waits for the answer of another local service of the same component
+	outer.post([&]() {
+		inner.post([&]() { inner_done.set_value(); });
+		outer_done.set_value(inner_future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+	});
+	ASSERT_EQ(outer_future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+	EXPECT_TRUE(outer_future.get());
+}
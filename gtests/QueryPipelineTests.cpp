@@ -0,0 +1,120 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "CommTestObjectsDDS/CommTextDDS.h"
+
+#include "RTI-DDS-SmartSoft/Component.h"
+#include "RTI-DDS-SmartSoft/LocalServiceRegistry.h"
+#include "RTI-DDS-SmartSoft/QueryClientPattern.h"
+#include "RTI-DDS-SmartSoft/QueryServerPattern.h"
+
+using CommTestObjects::CommText;
+
+// answers each query right away from within the query handler (i.e. possibly before the client's write() returns)
+class ImmediateAnswerHandler : public Smart::IQueryServerHandler<CommText, CommText> {
+public:
+	virtual void handleQuery(Smart::IQueryServerPattern<CommText, CommText> &server, const Smart::QueryIdPtr &id, const CommText &request) override
+	{
+		CommText answer;
+		answer.text = "answer-" + request.text;
+		server.answer(id, answer);
+	}
+};
+
+static void testPipelineWithImmediateAnswers(const std::string &service_name, const bool &use_local_service)
+{
+	SmartDDS::LocalServiceRegistry::instance().setEnabled(use_local_service);
+
+	SmartDDS::Component component("QueryPipelineTestComponent");
+	SmartDDS::QueryServerPattern<CommText, CommText> server(&component, service_name, std::make_shared<ImmediateAnswerHandler>());
+	SmartDDS::QueryClientPattern<CommText, CommText> client(&component);
+	ASSERT_EQ(client.connect("QueryPipelineTestComponent", service_name), Smart::StatusCode::SMART_OK);
+
+	std::vector<CommText> requests(200);
+	for(size_t i=0; i<requests.size(); ++i) {
+		requests[i].text = std::to_string(i);
+	}
+
+	std::vector<Smart::StatusCode> statuses(requests.size(), Smart::StatusCode::SMART_ERROR);
+	std::vector<std::string> answers(requests.size());
+	std::atomic<size_t> delivered_answers(0);
+	auto answer_handler = [&](const size_t &request_index, const Smart::StatusCode &status, const CommText &answer) {
+		statuses[request_index] = status;
+		answers[request_index] = answer.text;
+		delivered_answers++;
+	};
+
+	// a lost answer would only be delivered by its timeout (SMART_TIMEOUT) or block the pipeline forever
+	auto pipeline = std::async(std::launch::async, [&]() {
+		return client.queryPipelined(requests.begin(), requests.end(), 8, answer_handler,
+				SmartDDS::QueryPipelineOrder::REQUEST_ORDER, std::chrono::seconds(10));
+	});
+	ASSERT_EQ(pipeline.wait_for(std::chrono::seconds(60)), std::future_status::ready);
+	EXPECT_EQ(pipeline.get(), Smart::StatusCode::SMART_OK);
+
+	EXPECT_EQ(delivered_answers.load(), requests.size());
+	for(size_t i=0; i<requests.size(); ++i) {
+		EXPECT_EQ(statuses[i], Smart::StatusCode::SMART_OK) << "request " << i;
+		EXPECT_EQ(answers[i], "answer-" + requests[i].text);
+	}
+
+	EXPECT_EQ(client.disconnect(), Smart::StatusCode::SMART_OK);
+	SmartDDS::LocalServiceRegistry::instance().setEnabled(true);
+}
+
+TEST(QueryPipelineTest, TerminatesWithImmediateAnswersOverDDS)
+{
+	testPipelineWithImmediateAnswers("ImmediateAnswerDDSService", false);
+}
+
+TEST(QueryPipelineTest, TerminatesWithImmediateLocalAnswers)
+{
+	testPipelineWithImmediateAnswers("ImmediateAnswerLocalService", true);
+}
@@ -0,0 +1,155 @@
+//===================================================================================
+//
+//  Copyright (C) 2019 Alex Lotz
+//
+//        lotz@hs-ulm.de
+//
+//        Servicerobotik Ulm
+//        Christian Schlegel
+//        Ulm University of Applied Sciences
+//        Prittwitzstr. 10
+//        89075 Ulm
+//        Germany
+//
+//  This file is part of the SmartSoft Component-Developer C++ API.
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+//  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+//  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+//  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+//  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+//  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+//  OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//===================================================================================
+
+#include <thread>
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include "RTI-DDS-SmartSoft/TimeIndexedHistory.h"
+
+using History = SmartDDS::TimeIndexedHistory<double>;
+
+static History::TimePoint at(const int &milliseconds)
+{
+	return History::TimePoint(std::chrono::milliseconds(milliseconds));
+}
+
+static void fill(History &history, const int &count)
+{
+	// a value of i is published at i*10 ms
+	for(int i=0; i<count; ++i) {
+		history.push(at(i*10), std::make_shared<const double>(i));
+	}
+}
+
+TEST(TimeIndexedHistoryTest, ReturnsPrecedingValueWithoutInterpolator)
+{
+	History history(8);
+	fill(history, 5);
+
+	double value = -1.0;
+	EXPECT_TRUE(history.getAt(at(20), value));
+	EXPECT_EQ(value, 2.0);
+	EXPECT_TRUE(history.getAt(at(25), value));
+	EXPECT_EQ(value, 2.0);
+	EXPECT_TRUE(history.getAt(at(40), value));
+	EXPECT_EQ(value, 4.0);
+	// no extrapolation outside of the kept time range
+	EXPECT_FALSE(history.getAt(at(-1), value));
+	EXPECT_FALSE(history.getAt(at(41), value));
+}
+
+TEST(TimeIndexedHistoryTest, InterpolatesBetweenValues)
+{
+	History history(8, [](const double &before, const double &after, const double &ratio) {
+		return before + (after - before) * ratio;
+	});
+	fill(history, 5);
+
+	double value = -1.0;
+	EXPECT_TRUE(history.getAt(at(25), value));
+	EXPECT_DOUBLE_EQ(value, 2.5);
+	EXPECT_TRUE(history.getAt(at(30), value));
+	EXPECT_DOUBLE_EQ(value, 3.0);
+}
+
+TEST(TimeIndexedHistoryTest, KeepsOnlyTheLatestValues)
+{
+	History history(4);
+	fill(history, 10);
+
+	double value = -1.0;
+	EXPECT_FALSE(history.getAt(at(50), value));
+	EXPECT_TRUE(history.getAt(at(60), value));
+	EXPECT_EQ(value, 6.0);
+
+	std::vector<double> values;
+	EXPECT_TRUE(history.getBetween(at(0), at(1000), values));
+	EXPECT_EQ(values, std::vector<double>({6.0, 7.0, 8.0, 9.0}));
+
+	// older values are ignored
+	EXPECT_FALSE(history.push(at(5), std::make_shared<const double>(-1.0)));
+
+	history.clear();
+	EXPECT_FALSE(history.getBetween(at(0), at(1000), values));
+}
+
+TEST(TimeIndexedHistoryTest, ReturnsValuesBetweenInclusive)
+{
+	History history(16);
+	fill(history, 10);
+
+	std::vector<double> values;
+	EXPECT_TRUE(history.getBetween(at(20), at(50), values));
+	EXPECT_EQ(values, std::vector<double>({2.0, 3.0, 4.0, 5.0}));
+	EXPECT_TRUE(history.getBetween(at(21), at(29), values) == false);
+	EXPECT_TRUE(values.empty());
+}
+
+TEST(TimeIndexedHistoryTest, ConcurrentLookupsDuringWrites)
+{
+	History history(32);
+	std::atomic<bool> running(true);
+
+	std::thread writer([&]() {
+		for(int i=0; i<20000; ++i) {
+			history.push(at(i), std::make_shared<const double>(i));
+		}
+		running = false;
+	});
+
+	// each found value has to match its timestamp (i.e. no torn entries)
+	while(running) {
+		std::vector<double> values;
+		if(history.getBetween(at(0), at(20000), values)) {
+			for(size_t i=1; i<values.size(); ++i) {
+				ASSERT_EQ(values[i], values[i-1] + 1.0);
+			}
+			double value = -1.0;
+			if(history.getAt(at(static_cast<int>(values.back())), value)) {
+				ASSERT_GE(value, values.back());
+			}
+		}
+	}
+	writer.join();
+}